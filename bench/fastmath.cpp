@@ -0,0 +1,167 @@
+// shmup_fastmath_bench: FastMath against <cmath> — nanoseconds per call for each pair, plus the measured
+// error of every FastMath function. Exits with failure if any error exceeds the bound documented in FastMath.h.
+#include "FastMath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Documented bounds (FastMath.h)
+const double SIN_COS_MAX_ERROR = 1e-5;
+const double RSQRT_MAX_RELATIVE_ERROR = 2e-7;
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps results alive so the timed loops are not optimized away
+volatile float g_sink = 0.0f;
+
+// Nanoseconds per element for `body(i)` over `count` elements, best of `rounds`
+template <typename Body>
+double timePerCall(std::size_t count, int rounds, Body body) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; ++r) {
+        float sum = 0.0f;
+        Clock::time_point start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) sum += body(i);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(count);
+        g_sink = g_sink + sum;
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+// Sector of atan2(y, x) rounded to the nearest 45 degrees, as FastMath::octant defines it
+int referenceOctant(float x, float y) {
+    double degrees = std::atan2(static_cast<double>(y), static_cast<double>(x)) * 180.0 / 3.14159265358979323846;
+    return static_cast<int>(std::floor(degrees / 45.0 + 0.5)) & 7;
+}
+
+// True if the direction lies within `slackDegrees` of a sector edge, where float rounding may pick either side
+bool nearSectorEdge(float x, float y, double slackDegrees) {
+    double degrees = std::atan2(static_cast<double>(y), static_cast<double>(x)) * 180.0 / 3.14159265358979323846;
+    double fromEdge = std::fabs(std::fmod(degrees + 360.0 + 22.5, 45.0));
+    return fromEdge < slackDegrees || fromEdge > 45.0 - slackDegrees;
+}
+
+void printUsage(const char* program) {
+    std::fprintf(stderr, "Usage: %s [--count N] [--rounds N] [--seed N]\n", program);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t count = 1 << 20;
+    int rounds = 5;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (count == 0 || rounds < 1) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Inputs in the ranges the game uses: headings within a few turns, offsets across the playfield
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> angleDist(-4.0f * FastMath::PI, 4.0f * FastMath::PI);
+    std::uniform_real_distribution<float> offsetDist(-400.0f, 400.0f);
+    std::vector<float> angles(count), xs(count), ys(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        angles[i] = angleDist(rng);
+        xs[i] = offsetDist(rng);
+        ys[i] = offsetDist(rng);
+    }
+
+    // Timings
+    double sinCosStd = timePerCall(count, rounds, [&](std::size_t i) { return std::sin(angles[i]) + std::cos(angles[i]); });
+    double sinCosFast = timePerCall(count, rounds, [&](std::size_t i) {
+        float s, c;
+        FastMath::sinCos(angles[i], s, c);
+        return s + c;
+    });
+    double octantStd = timePerCall(count, rounds, [&](std::size_t i) {
+        float degrees = std::atan2(ys[i], xs[i]) * (180.0f / FastMath::PI);
+        return static_cast<float>(static_cast<int>(std::floor(degrees / 45.0f + 0.5f)) & 7);
+    });
+    double octantFast = timePerCall(count, rounds, [&](std::size_t i) { return static_cast<float>(FastMath::octant(xs[i], ys[i])); });
+    // Normalizing as the call sites used to: a square root and two divides
+    double normalizeStd = timePerCall(count, rounds, [&](std::size_t i) {
+        float length = std::sqrt(xs[i] * xs[i] + ys[i] * ys[i]);
+        return length > 0.0f ? xs[i] / length + ys[i] / length : 0.0f;
+    });
+    double normalizeFast = timePerCall(count, rounds, [&](std::size_t i) {
+        sf::Vector2f n = FastMath::normalize(sf::Vector2f(xs[i], ys[i]));
+        return n.x + n.y;
+    });
+
+    // Errors: a dense sweep for the table, random inputs for the rest
+    double sinCosError = 0.0;
+    const int sweep = 1 << 22;
+    for (int i = 0; i <= sweep; ++i) {
+        float angle = -64.0f + 128.0f * static_cast<float>(i) / static_cast<float>(sweep);
+        float s, c;
+        FastMath::sinCos(angle, s, c);
+        sinCosError = std::max(sinCosError, std::fabs(s - std::sin(static_cast<double>(angle))));
+        sinCosError = std::max(sinCosError, std::fabs(c - std::cos(static_cast<double>(angle))));
+    }
+    double rsqrtError = 0.0;
+    for (int e = -40; e <= 40; ++e) {
+        for (int m = 0; m < 4096; ++m) {
+            float x = std::ldexp(1.0f + static_cast<float>(m) / 4096.0f, e);
+            double exact = 1.0 / std::sqrt(static_cast<double>(x));
+            rsqrtError = std::max(rsqrtError, std::fabs(FastMath::rsqrt(x) - exact) / exact);
+        }
+    }
+    std::size_t octantMismatches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (FastMath::octant(xs[i], ys[i]) != referenceOctant(xs[i], ys[i]) && !nearSectorEdge(xs[i], ys[i], 1e-4)) {
+            ++octantMismatches;
+        }
+    }
+    // The eight exact headings, and the zero vector
+    const float axes[8][2] = { {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1} };
+    for (int o = 0; o < 8; ++o) {
+        if (FastMath::octant(axes[o][0], axes[o][1]) != o) ++octantMismatches;
+        if (FastMath::octantFromAngle(static_cast<float>(o) * FastMath::PI / 4.0f) != o) ++octantMismatches;
+    }
+    if (FastMath::octant(0.0f, 0.0f) != 0) ++octantMismatches;
+
+    std::printf("{\n  \"benchmark\": \"shmup_fastmath_bench\",\n  \"count\": %zu,\n  \"rounds\": %d,\n  \"seed\": %u,\n", count, rounds, seed);
+    std::printf("  \"ns_per_call\": {\n");
+    std::printf("    \"sincos\": { \"cmath\": %.3f, \"fast\": %.3f },\n", sinCosStd, sinCosFast);
+    std::printf("    \"octant\": { \"cmath\": %.3f, \"fast\": %.3f },\n", octantStd, octantFast);
+    std::printf("    \"normalize\": { \"cmath\": %.3f, \"fast\": %.3f }\n  },\n", normalizeStd, normalizeFast);
+    std::printf("  \"max_error\": {\n    \"sincos_abs\": %.3g,\n    \"rsqrt_rel\": %.3g,\n    \"octant_mismatches\": %zu\n  }\n}\n",
+                sinCosError, rsqrtError, octantMismatches);
+
+    bool ok = true;
+    if (sinCosError > SIN_COS_MAX_ERROR) {
+        std::fprintf(stderr, "sinCos error %g exceeds the documented %g\n", sinCosError, SIN_COS_MAX_ERROR);
+        ok = false;
+    }
+    if (rsqrtError > RSQRT_MAX_RELATIVE_ERROR) {
+        std::fprintf(stderr, "rsqrt relative error %g exceeds the documented %g\n", rsqrtError, RSQRT_MAX_RELATIVE_ERROR);
+        ok = false;
+    }
+    if (octantMismatches > 0) {
+        std::fprintf(stderr, "octant disagrees with atan2 for %zu directions\n", octantMismatches);
+        ok = false;
+    }
+    return ok ? 0 : EXIT_FAILURE;
+}
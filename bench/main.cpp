@@ -0,0 +1,371 @@
+// shmup_bench: scripted bullet-hell scenes run through the real Simulation, reporting
+// per-phase frame timings and heap allocations as JSON for tracking regressions.
+#include "Simulation.h"
+#include "Enemy.h"
+#include "ShootingPattern.h"
+#include "SpriteBatch.h"
+#include "Profiler.h"
+#include "AssetCache.h"
+#include "JobSystem.h"
+#include "ProjectileKernel.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Count every heap allocation made by the process
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Scene {
+    int enemies;
+    std::size_t projectiles;
+    int burstWays; // > 0: every enemy fires the same radial burst on the same tick (spawn spikes)
+    bool scripted; // every enemy runs BENCH_SCRIPT, whose bullets all stay under the VM for seconds
+};
+
+// A ring of slow bullets circling in place: each one keeps a runner for the whole eight-second turn
+const char* const BENCH_SCRIPT =
+    "action top\n"
+    "  repeat 32\n"
+    "    fire sequence 11.25 absolute 40 circle\n"
+    "  end\n"
+    "end\n"
+    "action circle\n"
+    "  turn sequence 45 8\n"
+    "end\n";
+
+struct Summary {
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+Summary summarize(std::vector<double> samples) {
+    Summary s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[static_cast<std::size_t>(q * (samples.size() - 1) + 0.5)]; };
+    s.p50 = at(0.50);
+    s.p99 = at(0.99);
+    s.max = samples.back();
+    return s;
+}
+
+void printSummary(std::FILE* out, const char* name, const Summary& s, bool last) {
+    std::fprintf(out, "        \"%s\": {\"p50_us\": %.2f, \"p99_us\": %.2f, \"max_us\": %.2f}%s\n",
+                 name, s.p50, s.p99, s.max, last ? "" : ",");
+}
+
+// Keep the pool at `target` live projectiles by spawning enemy shots at random spots
+void topUpProjectiles(ProjectilePool& pool, std::size_t target, std::mt19937& rng) {
+    std::uniform_real_distribution<float> x(0.0f, static_cast<float>(Simulation::WORLD_WIDTH));
+    std::uniform_real_distribution<float> y(0.0f, static_cast<float>(Simulation::WORLD_HEIGHT));
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * 3.14159265f);
+    while (pool.size() < target && !pool.full()) {
+        pool.spawn(x(rng), y(rng), angle(rng), 160.0f, Projectile::Owner::Enemy);
+    }
+}
+
+// Run every available kernel version on the same awkward inputs (odd lengths, unaligned starts, lifetimes
+// about to run out, positions on the cull box edges) and compare each output bit for bit with the scalar version
+bool kernelsMatchScalar(unsigned seed) {
+    const std::size_t count = 1031;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-80.0f, 400.0f);
+    std::uniform_real_distribution<float> vel(-600.0f, 600.0f);
+    std::uniform_real_distribution<float> life(-0.02f, 0.05f);
+    const float dt = 1.0f / 120.0f;
+    const CullBox box{-50.0f, -50.0f, 370.0f, 274.0f};
+
+    struct Data {
+        std::vector<float> posX, posY, prevX, prevY, velX, velY, lifetime;
+        std::vector<std::uint8_t> cull;
+        ProjectileStreams streams() {
+            return ProjectileStreams{posX.data(), posY.data(), prevX.data(), prevY.data(),
+                                     velX.data(), velY.data(), lifetime.data(), cull.data()};
+        }
+    } input;
+    for (std::size_t i = 0; i < count; ++i) {
+        input.posX.push_back(i % 17 == 0 ? box.maxX : pos(rng));
+        input.posY.push_back(i % 19 == 0 ? box.minY : pos(rng));
+        input.velX.push_back(i % 17 == 0 ? 0.0f : vel(rng));
+        input.velY.push_back(i % 19 == 0 ? 0.0f : vel(rng));
+        input.lifetime.push_back(i % 7 == 0 ? dt : (i % 5 == 0 ? -1.0f : life(rng)));
+    }
+    input.prevX.assign(count, 0.0f);
+    input.prevY.assign(count, 0.0f);
+    input.cull.assign(count, 2);
+
+    const ProjectileKernel::Isa versions[] = { ProjectileKernel::Isa::SSE2, ProjectileKernel::Isa::AVX2 };
+    for (ProjectileKernel::Isa isa : versions) {
+        ProjectileKernel::Fn fn = ProjectileKernel::get(isa);
+        if (!fn) continue;
+        // A few [begin, end) windows, several steps each, so tails and unaligned heads are covered
+        const std::size_t windows[][2] = { {0, count}, {3, count - 2}, {5, 12}, {0, 3} };
+        for (const auto& w : windows) {
+            Data reference = input;
+            Data candidate = input;
+            for (int step = 0; step < 4; ++step) {
+                ProjectileKernel::integrateScalar(reference.streams(), w[0], w[1], dt, box);
+                fn(candidate.streams(), w[0], w[1], dt, box);
+            }
+            auto same = [](const std::vector<float>& a, const std::vector<float>& b) {
+                return std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+            };
+            if (!same(reference.posX, candidate.posX) || !same(reference.posY, candidate.posY)
+                || !same(reference.prevX, candidate.prevX) || !same(reference.prevY, candidate.prevY)
+                || !same(reference.lifetime, candidate.lifetime) || reference.cull != candidate.cull) {
+                std::fprintf(stderr, "Projectile kernel '%s' differs from the scalar version on [%zu, %zu)\n",
+                             ProjectileKernel::name(isa), w[0], w[1]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Frames of a sheet as packed by the game's atlas; a stock 64x96 sheet if the assets are not around
+SpriteAnimation benchAnimation(const AssetCache& layout, const std::string& name, const sf::Texture& atlas) {
+    sf::IntRect rect = layout.getSheetRect(name);
+    if (rect.size.x == 0) rect = sf::IntRect(sf::Vector2i(0, 0), sf::Vector2i(64, 96));
+    return makeGridAnimation(&atlas, rect, sf::Vector2i(32, 32));
+}
+
+void runScene(std::FILE* out, Profiler& profiler, JobSystem* jobs, const AssetCache& layout, const Scene& scene,
+              int frames, int warmup, float dt, unsigned seed, bool last) {
+    std::mt19937 rng(seed);
+
+    std::size_t capacity = std::max<std::size_t>(ProjectilePool::DEFAULT_CAPACITY, scene.projectiles * 2);
+    Simulation simulation(capacity);
+    simulation.setSeed(seed);
+    simulation.setProfiler(&profiler);
+    simulation.setJobSystem(jobs);
+
+    // Enemies spread over the right of the field, alternating the two stock patterns
+    std::uniform_real_distribution<float> ex(Simulation::WORLD_WIDTH * 0.4f, Simulation::WORLD_WIDTH * 0.95f);
+    std::uniform_real_distribution<float> ey(Simulation::WORLD_HEIGHT * 0.05f, Simulation::WORLD_HEIGHT * 0.95f);
+    EnemyWorld& enemies = simulation.getEnemies();
+    // The program has to outlive the simulation's use of it
+    BulletProgram program;
+    std::string error;
+    if (!compileBulletScript(BENCH_SCRIPT, program, error)) {
+        std::fprintf(stderr, "Bench script: %s\n", error.c_str());
+        std::exit(EXIT_FAILURE);
+    }
+    simulation.getBullets().setProgram(program);
+    std::int32_t scripted = enemies.addPattern(makeScriptedPattern(0, 1.0f));
+    std::int32_t burst = enemies.addPattern(makeRadialPattern(scene.burstWays > 0 ? scene.burstWays : 16,
+                                                              scene.burstWays > 0 ? 0.5f : 1.0f, 160.0f));
+    std::int32_t aimed = enemies.addPattern(makeDirectAtPlayerPattern(0.5f, 220.0f, 800.0f, true));
+    for (int i = 0; i < scene.enemies; ++i) {
+        EnemyId enemy = enemies.spawn(ex(rng), ey(rng), 40.0f);
+        if (scene.scripted) enemies.setPattern(enemy, scripted);
+        else enemies.setPattern(enemy, scene.burstWays > 0 || i % 2 == 0 ? burst : aimed);
+    }
+
+    // One texture with no pixels stands in for the atlas: render preparation only needs it as a batch key
+    sf::Texture atlas;
+    SpriteAnimation playerShot = benchAnimation(layout, "shot", atlas);
+    SpriteAnimation enemyShot = benchAnimation(layout, "ufo_beam", atlas);
+    SpriteAnimation ufo = benchAnimation(layout, "ufo", atlas);
+    SpriteBatch batch;
+
+    std::vector<double> tick, update, collisions, scripts, renderPrep, allocations;
+    tick.reserve(frames);
+    update.reserve(frames);
+    collisions.reserve(frames);
+    scripts.reserve(frames);
+    renderPrep.reserve(frames);
+    allocations.reserve(frames);
+    double liveSum = 0.0;
+    double runnerSum = 0.0;
+
+    using Clock = std::chrono::steady_clock;
+    for (int f = 0; f < warmup + frames; ++f) {
+        topUpProjectiles(simulation.getProjectiles(), scene.projectiles, rng);
+
+        std::size_t allocBefore = g_allocations.load(std::memory_order_relaxed);
+        profiler.beginFrame();
+        Clock::time_point tickStart = Clock::now();
+        simulation.update(dt);
+        Clock::time_point tickEnd = Clock::now();
+
+        Clock::time_point prepStart = Clock::now();
+        batch.resetStats();
+        Projectile::draw(simulation.getProjectiles(), batch, playerShot, enemyShot);
+        Enemy::draw(simulation.getEnemies(), batch, ufo);
+        Clock::time_point prepEnd = Clock::now();
+        profiler.endFrame();
+        std::size_t allocAfter = g_allocations.load(std::memory_order_relaxed);
+
+        // Drop the queued quads without a render target
+        batch.discard();
+
+        if (f < warmup) continue;
+        // Phase split comes from the simulation's profiler scopes (zero when profiling is compiled out)
+        FrameProfile frame;
+        profiler.readFrame(0, frame);
+        tick.push_back(std::chrono::duration<double, std::micro>(tickEnd - tickStart).count());
+        update.push_back(frame.phaseMs[static_cast<std::size_t>(ProfilePhase::Update)] * 1e3);
+        collisions.push_back(frame.phaseMs[static_cast<std::size_t>(ProfilePhase::Collisions)] * 1e3);
+        scripts.push_back(frame.phaseMs[static_cast<std::size_t>(ProfilePhase::Scripts)] * 1e3);
+        renderPrep.push_back(std::chrono::duration<double, std::micro>(prepEnd - prepStart).count());
+        allocations.push_back(static_cast<double>(allocAfter - allocBefore));
+        liveSum += static_cast<double>(simulation.getProjectiles().size());
+        runnerSum += static_cast<double>(simulation.getBullets().size());
+    }
+
+    double allocTotal = 0.0;
+    double allocMax = 0.0;
+    for (double a : allocations) {
+        allocTotal += a;
+        allocMax = std::max(allocMax, a);
+    }
+
+    std::fprintf(out, "    {\n");
+    std::fprintf(out, "      \"enemies\": %d,\n", scene.enemies);
+    std::fprintf(out, "      \"projectiles\": %zu,\n", scene.projectiles);
+    std::fprintf(out, "      \"burst_ways\": %d,\n", scene.burstWays);
+    std::fprintf(out, "      \"scripted\": %s,\n", scene.scripted ? "true" : "false");
+    std::fprintf(out, "      \"frames\": %d,\n", frames);
+    std::fprintf(out, "      \"live_projectiles_mean\": %.1f,\n", frames > 0 ? liveSum / frames : 0.0);
+    std::fprintf(out, "      \"script_runners_mean\": %.1f,\n", frames > 0 ? runnerSum / frames : 0.0);
+    std::fprintf(out, "      \"state_hash\": \"%016llx\",\n", static_cast<unsigned long long>(simulation.stateHash()));
+    std::fprintf(out, "      \"phases\": {\n");
+    printSummary(out, "tick", summarize(tick), false);
+    printSummary(out, "update", summarize(update), false);
+    printSummary(out, "collisions", summarize(collisions), false);
+    printSummary(out, "scripts", summarize(scripts), false);
+    printSummary(out, "render_prep", summarize(renderPrep), true);
+    std::fprintf(out, "      },\n");
+    std::fprintf(out, "      \"allocations_per_frame\": {\"mean\": %.2f, \"max\": %.0f}\n",
+                 frames > 0 ? allocTotal / frames : 0.0, allocMax);
+    std::fprintf(out, "    }%s\n", last ? "" : ",");
+    std::fflush(out);
+}
+
+void printUsage(const char* exe) {
+    std::printf("Usage: %s [--frames N] [--warmup N] [--dt SECONDS] [--seed N] [--threads N] [--kernel NAME] [--quick] [--out FILE]\n"
+                "  --frames N     measured frames per scene (default 300)\n"
+                "  --warmup N     unmeasured frames before each scene (default 30)\n"
+                "  --dt SECONDS   tick length (default 1/120)\n"
+                "  --seed N       RNG seed for enemy placement and projectile top-up (default 1)\n"
+                "  --threads N    threads sharing the simulation update; 1 = serial (default: one per core)\n"
+                "  --kernel NAME  projectile kernel: scalar, sse2 or avx2 (default: widest the CPU supports)\n"
+                "  --quick        only the smallest projectile count per enemy count\n"
+                "  --out FILE     write JSON to FILE instead of stdout\n", exe);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = 300;
+    int warmup = 30;
+    float dt = 1.0f / 120.0f;
+    unsigned seed = 1;
+    int threads = 0;
+    const char* kernel = nullptr;
+    bool quick = false;
+    const char* outPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            warmup = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) {
+            dt = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) {
+            kernel = argv[++i];
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const int enemyCounts[] = { 10, 100, 1000, 5000 };
+    const std::size_t projectileCounts[] = { 1000, 10000, 50000, 200000 };
+    std::vector<Scene> scenes;
+    for (int e : enemyCounts) {
+        for (std::size_t p : projectileCounts) {
+            scenes.push_back(Scene{e, p, 0, false});
+            if (quick) break;
+        }
+    }
+    // 200 enemies firing 64-way bursts in lockstep: 12800 spawns in a single tick
+    scenes.push_back(Scene{200, 0, 64, false});
+    // 1000 enemies each starting a 32-bullet scripted ring every second, every bullet still curving under the VM
+    scenes.push_back(Scene{1000, 0, 0, true});
+
+    // Every vectorized kernel must reproduce the scalar results exactly before anything is timed
+    if (!kernelsMatchScalar(seed)) return EXIT_FAILURE;
+    if (kernel) {
+        bool known = false;
+        const ProjectileKernel::Isa versions[] = { ProjectileKernel::Isa::Scalar, ProjectileKernel::Isa::SSE2, ProjectileKernel::Isa::AVX2 };
+        for (ProjectileKernel::Isa isa : versions) {
+            if (std::strcmp(kernel, ProjectileKernel::name(isa)) == 0) known = ProjectileKernel::select(isa);
+        }
+        if (!known) {
+            std::fprintf(stderr, "Projectile kernel '%s' is not available on this machine\n", kernel);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Cannot open %s for writing\n", outPath);
+        return EXIT_FAILURE;
+    }
+
+    // Atlas layout only (decoded and packed, never uploaded), so quads get the game's frame rects
+    AssetCache layout;
+    layout.loadImages("assets/characters");
+
+    // Large ring buffer: keep it off the stack
+    std::unique_ptr<Profiler> profiler = std::make_unique<Profiler>();
+    // Serial runs use no job system at all, so they measure the plain single-threaded path
+    std::unique_ptr<JobSystem> jobs;
+    if (threads != 1) {
+        jobs = std::make_unique<JobSystem>(threads > 1 ? static_cast<std::size_t>(threads - 1) : JobSystem::defaultWorkerCount());
+    }
+
+    std::fprintf(out, "{\n  \"benchmark\": \"shmup_bench\",\n  \"profiling\": %s,\n  \"threads\": %zu,\n  \"kernel\": \"%s\",\n  \"dt\": %.6f,\n  \"seed\": %u,\n  \"scenes\": [\n",
+                 SHMUP_PROFILING ? "true" : "false", jobs ? jobs->getThreadCount() : std::size_t(1),
+                 ProjectileKernel::name(ProjectileKernel::selected()), dt, seed);
+    for (std::size_t i = 0; i < scenes.size(); ++i) {
+        runScene(out, *profiler, jobs.get(), layout, scenes[i], frames, warmup, dt, seed, i + 1 == scenes.size());
+    }
+    std::fprintf(out, "  ]\n}\n");
+
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
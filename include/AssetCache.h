@@ -0,0 +1,81 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class JobSystem;
+
+// Frame rects of one sprite sheet inside an atlas page
+struct SpriteAnimation {
+    const sf::Texture* texture = nullptr;
+    std::vector<sf::IntRect> frames; // row-major order of the original sheet
+
+    bool empty() const { return texture == nullptr || frames.empty(); }
+    std::size_t frameCount() const { return frames.size(); }
+    // Wraps around, so callers can pass a free-running frame counter
+    const sf::IntRect& frame(std::size_t index) const { return frames[index % frames.size()]; }
+};
+
+// Split `area` of a texture into frameSize cells, row-major (partial cells are ignored)
+SpriteAnimation makeGridAnimation(const sf::Texture* texture, const sf::IntRect& area, sf::Vector2i frameSize);
+
+// Loads every sprite sheet under a directory once and packs them into shared atlas textures.
+// - Sheets are named by their path relative to the directory, without extension ("ufo", "player/player_sky")
+// - Each sheet is cut into frameSize cells, so a 64x96 sheet of 32x32 frames is a 6-frame animation
+// - Sheets go onto as few ATLAS_SIZE pages as fit (normally one), so sprites share a texture
+//   and a SpriteBatch draws them all with one call
+// Loading is split in two: loadImages() only decodes and packs (no GPU needed, so it can run on any thread,
+// with the decoding spread over a job system), createTextures() uploads the pages and hands out texture pointers.
+class AssetCache {
+public:
+    static const unsigned ATLAS_SIZE = 2048;
+    static const unsigned PADDING = 2; // empty pixels around each sheet against filtering bleed
+
+    explicit AssetCache(sf::Vector2i frameSize = sf::Vector2i(32, 32));
+
+    // Decode every .png under `directory` and pack them, replacing whatever was loaded before
+    // (animations and textures handed out earlier become invalid). False if nothing could be loaded.
+    // With a job system the files are decoded in parallel; the result is the same either way.
+    bool loadImages(const std::string& directory, JobSystem* jobs = nullptr);
+    // Upload the packed pages. Animations have no texture until this succeeds.
+    bool createTextures();
+    // Both steps
+    bool load(const std::string& directory);
+
+    // Animation by name, or nullptr if no such sheet was loaded
+    const SpriteAnimation* find(const std::string& name) const;
+    // Same, but never null: missing names give an empty animation
+    const SpriteAnimation& get(const std::string& name) const;
+
+    std::size_t getPageCount() const { return pageCount; }
+    std::size_t getSheetCount() const { return animations.size(); }
+    // Rect of a whole sheet inside its page (empty if unknown)
+    sf::IntRect getSheetRect(const std::string& name) const;
+    // Milliseconds each loaded sheet took to decode, in load order (startup logging)
+    std::vector<std::pair<std::string, float>> getDecodeTimes() const;
+
+private:
+    struct Sheet {
+        std::string name;
+        sf::Image image;
+        std::size_t page = 0;
+        sf::IntRect rect; // placement in the page
+        float decodeMs = 0.0f;
+    };
+
+    void pack();
+
+    sf::Vector2i frameSize;
+    std::vector<Sheet> sheets;
+    std::size_t pageCount;
+    std::vector<std::unique_ptr<sf::Texture>> pages;
+    std::map<std::string, SpriteAnimation> animations;
+};
+
+#endif // ASSET_CACHE_H
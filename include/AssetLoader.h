@@ -0,0 +1,73 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AssetCache;
+class JobSystem;
+class SoundBank;
+
+// Startup loading off the main thread, so the window can show a loading screen meanwhile.
+// - Sprite sheets are decoded in parallel on the job system; the font, the music and the sound effects load on
+//   threads of their own
+// - Only the texture upload is left for the main thread (finish()), since it needs the GL context
+// - Every asset's load time is logged, plus the total startup time
+// The cache, font, music, sound bank and job system must outlive the loader and stay untouched until isReady().
+class AssetLoader {
+public:
+    AssetLoader(AssetCache& assets, sf::Font& font, sf::Music& music, SoundBank& sounds, JobSystem& jobs);
+    ~AssetLoader(); // waits for any loading still running
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Begin loading. The first existing, playable music path wins. Sound effects come from soundDirectory
+    // (see SoundEffects::load()).
+    void start(const std::string& spriteDirectory, const std::string& fontPath,
+               const std::vector<std::string>& musicPaths, const std::string& soundDirectory);
+    // True once every background load has finished
+    bool isReady() const { return pending.load(std::memory_order_acquire) == 0; }
+    // Finished share of the background loads, in [0, 1]
+    float getProgress() const;
+
+    // Main thread, once isReady(): upload the atlas and log the timings. Returns true if the sprites are usable.
+    bool finish();
+
+    bool hasFont() const { return fontLoaded; }
+    bool hasMusic() const { return !musicPath.empty(); }
+    const std::string& getMusicPath() const { return musicPath; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    // Milliseconds since `start`
+    static float millisecondsSince(Clock::time_point start);
+
+    AssetCache& assets;
+    sf::Font& font;
+    sf::Music& music;
+    SoundBank& sounds;
+    JobSystem& jobs;
+
+    std::vector<std::thread> threads;
+    std::atomic<int> pending;
+    int total;
+    Clock::time_point startTime;
+
+    // Results, each written by one loading thread and read after isReady()
+    bool spritesLoaded;
+    bool fontLoaded;
+    std::string musicPath;
+    int soundFiles;
+    float spritesMs;
+    float fontMs;
+    float musicMs;
+    float soundsMs;
+};
+
+#endif // ASSET_LOADER_H
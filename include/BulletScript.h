@@ -0,0 +1,88 @@
+#ifndef BULLET_SCRIPT_H
+#define BULLET_SCRIPT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Bytecode for scripted barrages, in the spirit of BulletML. A program is three flat arrays:
+// instructions, actions (each a range of instructions) and scripts (each the index of its top action).
+// - A script's top action runs from an emitter; `fire` can hand each new bullet an action of its own,
+//   which steers that bullet and can fire sub-bullets from it
+// - Instructions are fixed-size records with no pointers, so a program can be run straight from a mapped level file
+// - Angles are radians (clockwise on screen, 0 = right), speeds world units per second, times seconds
+namespace BulletCode {
+    enum Op : std::uint8_t {
+        Fire,       // spawn a bullet: direction a (by the low mode nibble), speed b (by the high nibble), action arg
+        Wait,       // pause this action for a seconds
+        Repeat,     // run the instructions up to the matching Loop arg times
+        Loop,       // end of a Repeat body: jump back arg instructions while iterations remain
+        Turn,       // change direction towards a (by mode) over b seconds; Sequence: turn at a radians per second
+        Accelerate, // change speed towards a (by mode) over b seconds; Sequence: a units per second squared
+        Vanish,     // remove the bullet running this action (ends an emitter)
+        OpCount
+    };
+
+    // How an instruction's angle or speed is read
+    enum Mode : std::uint8_t {
+        Aim,      // relative to the direction from the runner to the player (angles only)
+        Absolute,
+        Relative, // relative to the runner's own direction or speed
+        Sequence, // relative to the previous fire of the same runner; for Turn/Accelerate, a rate
+        ModeCount
+    };
+
+    static constexpr std::uint16_t NO_ACTION = 0xFFFF;
+    // Deepest Repeat nesting a runner keeps counters for
+    static constexpr std::size_t MAX_LOOP_DEPTH = 4;
+
+    struct Instruction {
+        std::uint8_t op;    // Op
+        std::uint8_t mode;  // Mode; Fire packs the direction mode in the low nibble and the speed mode in the high one
+        std::uint16_t arg;  // Fire: bullet action or NO_ACTION; Repeat: count; Loop: jump distance
+        float a;
+        float b;
+    };
+
+    // Instructions [first, first + count)
+    struct Action {
+        std::uint32_t first;
+        std::uint32_t count;
+    };
+
+    static_assert(sizeof(Instruction) == 12 && sizeof(Action) == 8, "bullet bytecode layout changed");
+}
+
+// Compiled scripts, in the arrays a BulletVM runs from
+struct BulletProgram {
+    std::vector<BulletCode::Instruction> instructions;
+    std::vector<BulletCode::Action> actions;
+    std::vector<std::uint32_t> scripts; // top action of each script
+};
+
+// Compile one script's text and append it to `program` as its next script.
+// On failure returns false, leaves `program` unchanged and describes the first bad line in `error`.
+//
+// Source format, one statement per line ('#' starts a comment, angles in degrees):
+//   action <name>                       start an action; the script runs the one named "top"
+//   end                                 close the innermost action or repeat
+//   fire <dir-mode> <degrees> <speed-mode> <speed> [<action>]
+//   wait <seconds>
+//   repeat <count>                      up to 4 deep
+//   turn <dir-mode> <degrees> <seconds>
+//   speed <speed-mode> <value> <seconds>
+//   vanish
+// Direction modes: aim, absolute, relative, sequence. Speed modes: absolute, relative, sequence.
+// Actions may be used by fire before they are defined.
+bool compileBulletScript(const std::string& source, BulletProgram& program, std::string& error);
+// Same, reading the source from a file
+bool loadBulletScript(const std::string& path, BulletProgram& program, std::string& error);
+
+// Check that every index in a program stays inside its arrays and every loop is well formed,
+// so a VM can run it without bounds checks. False with a message in `error` otherwise.
+bool validateBulletProgram(const BulletCode::Instruction* instructions, std::size_t instructionCount,
+                           const BulletCode::Action* actions, std::size_t actionCount,
+                           const std::uint32_t* scripts, std::size_t scriptCount, std::string& error);
+
+#endif // BULLET_SCRIPT_H
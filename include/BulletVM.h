@@ -0,0 +1,85 @@
+#ifndef BULLET_VM_H
+#define BULLET_VM_H
+
+#include "BulletScript.h"
+#include "ProjectilePool.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Interpreter for BulletCode programs, running every active action of every emitter and scripted bullet.
+// - Runners live in one fixed-capacity array, allocated once; running an instruction never touches the heap
+// - Instructions are read in place from the program's flat arrays (e.g. a mapped level)
+// - A bullet keeps a runner only while its action runs or it is still turning or changing speed;
+//   after that it flies on as a plain projectile
+// - One serial pass in runner order, so the same inputs fire the same bullets on any thread count
+class BulletVM {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = ProjectilePool::DEFAULT_CAPACITY;
+    // Instructions one runner may execute in a tick; a loop with no wait in it yields here until the next tick
+    static const int MAX_STEPS_PER_TICK = 1024;
+
+    explicit BulletVM(std::size_t capacity = DEFAULT_CAPACITY);
+
+    // Run scripts from these arrays, which must stay alive and unchanged while the VM uses them and must
+    // have passed validateBulletProgram(). Stops every runner.
+    void setProgram(const BulletCode::Instruction* instructions, std::size_t instructionCount,
+                    const BulletCode::Action* actions, std::size_t actionCount,
+                    const std::uint32_t* scripts, std::size_t scriptCount);
+    void setProgram(const BulletProgram& program);
+    std::size_t getScriptCount() const { return m_scriptCount; }
+
+    // Start a script's top action from (x, y), initially facing `target`. It runs from that spot even if
+    // whatever launched it moves on or dies. False when the script does not exist or the VM is full.
+    bool launch(std::int32_t script, float x, float y, const sf::Vector2f& target);
+    // Start every launch in the batch, in order
+    void launch(const ProjectileSpawnBatch& batch, const sf::Vector2f& target);
+
+    // Advance every runner by deltaTime: run due instructions (firing into `projectiles`), then apply
+    // turning and acceleration to the bullets. Runners started during the pass first run next tick.
+    void update(float deltaTime, ProjectilePool& projectiles, const sf::Vector2f& target);
+    // Stop every runner (their bullets fly on)
+    void clear() { m_size = 0; }
+
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_capacity; }
+
+private:
+    struct Runner {
+        ProjectileHandle bullet;   // invalid for an emitter
+        float x;                   // emitter position (bullets use their projectile's)
+        float y;
+        std::uint32_t pc;          // next instruction
+        std::uint32_t end;         // one past the action's last instruction
+        float wait;                // seconds before the next instruction
+        float direction;           // radians
+        float speed;
+        float turnRate;            // radians per second, for turnTime more seconds
+        float turnTime;
+        float acceleration;        // per second, for accelerationTime more seconds
+        float accelerationTime;
+        float lastDirection;       // of the previous fire, for Sequence
+        float lastSpeed;
+        std::uint16_t loopLeft[BulletCode::MAX_LOOP_DEPTH];
+        std::uint8_t loopDepth;
+    };
+
+    // Runner for an action, facing `direction` at `speed`
+    Runner makeRunner(std::uint32_t action, float direction, float speed) const;
+    // One tick of one runner. False once it has nothing left to do.
+    bool step(Runner& runner, float deltaTime, ProjectilePool& projectiles, const sf::Vector2f& target);
+    void fire(Runner& runner, const BulletCode::Instruction& in, const sf::Vector2f& position,
+              ProjectilePool& projectiles, const sf::Vector2f& target);
+
+    std::size_t m_capacity;
+    std::size_t m_size;
+    std::vector<Runner> m_runners;
+
+    const BulletCode::Instruction* m_instructions;
+    const BulletCode::Action* m_actions;
+    const std::uint32_t* m_scripts;
+    std::size_t m_scriptCount;
+};
+
+#endif // BULLET_VM_H
@@ -2,63 +2,33 @@
 #define ENEMY_H
 
 #include <SFML/Graphics.hpp>
-#include <memory>
-#include <vector>
-#include "Path.h"
 
-// Forward declarations
-class Projectile;
-class ShootingPattern;
+class EnemyWorld;
+class SpriteBatch;
+class AssetCache;
+struct SpriteAnimation;
 
+// Shared enemy definitions and rendering.
+// Per-enemy state lives in EnemyWorld's component arrays; this class owns what all enemies have in common.
 class Enemy {
 public:
-    Enemy(float x, float y, float speed = 100.0f);
-    
-    // Now accepts player position and projectiles list so enemies can spawn bullets
-    void update(float deltaTime, int screenWidth, int screenHeight, const sf::Vector2f& playerPos, std::vector<std::unique_ptr<Projectile>>& projectiles);
-    void draw(sf::RenderWindow& window);
-    
-    sf::Vector2f getPosition() const;
-    sf::FloatRect getBounds() const;
-    
-    int getHealth() const;
-    void takeDamage(int damage);
-    bool isDead() const;
-    // Path movement
-    void setPath(std::unique_ptr<Path> p);
-    bool hasPath() const;
-    // Shooting pattern
-    void setShootingPattern(std::unique_ptr<ShootingPattern> p);
-    
-private:
-    sf::Vector2f position;
-    sf::Vector2f velocity;
-    float speed;
-    int health;
-    int maxHealth;
-    
-    // Animation
-    static std::unique_ptr<sf::Texture> texture;
-    static const int FRAME_COLS = 2;
-    static const int FRAME_ROWS = 3;
-    static const int TOTAL_FRAMES = FRAME_COLS * FRAME_ROWS;
+    // Animation cycle length; the frame rects come from the asset cache
+    static const int TOTAL_FRAMES = 6;
+    static constexpr float FRAME_DURATION = 0.08f;
+    // Size of one sheet frame in pixels; also used as the hit box
+    static constexpr float FRAME_SIZE = 32.0f;
+
+    // Queue every live enemy in the world into the batch (one quad each).
+    // alpha blends between the previous and current tick positions.
+    static void draw(const EnemyWorld& world, SpriteBatch& batch, float alpha = 1.0f);
+    // Same, with a caller-provided animation (e.g. to batch without loading textures on a GPU)
+    static void draw(const EnemyWorld& world, SpriteBatch& batch, const SpriteAnimation& animation, float alpha = 1.0f);
 
-    std::unique_ptr<sf::Sprite> sprite;
-    int currentFrame;
-    float animationTimer;
-    float frameDuration;
+    // Shared animation ("ufo") from the asset cache; only the front-end sets it, so enemies simulate without a display
+    static bool loadTexture(const AssetCache& assets);
 
-    // Movement pattern
-    float movementTimer;
-    float directionChangeInterval;
-    std::unique_ptr<Path> path;
-    std::unique_ptr<ShootingPattern> shooter;
-    
-    // Internal helpers
-    void updateAnimation(float deltaTime);
-    void updateSpriteRect();
-    void updateMovement(float deltaTime, int screenWidth, int screenHeight);
-    static bool loadTexture();
+private:
+    static const SpriteAnimation* animation;
 };
 
 #endif // ENEMY_H
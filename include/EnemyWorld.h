@@ -0,0 +1,201 @@
+#ifndef ENEMY_WORLD_H
+#define ENEMY_WORLD_H
+
+#include "ShootingPattern.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class ProjectileSpawnBatch;
+class PathTrack;
+
+// Generational reference to an enemy stored in an EnemyWorld.
+// An id goes stale as soon as its enemy is removed, even if the slot is reused later.
+struct EnemyId {
+    static constexpr std::uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+    std::uint32_t slot = INVALID_SLOT;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return slot != INVALID_SLOT; }
+};
+
+// Components. Each lives in its own dense array, indexed like every other component of the same enemy.
+struct EnemyTransform {
+    sf::Vector2f position;
+    sf::Vector2f previous; // position before the last update (render interpolation)
+};
+
+struct EnemyMotion {
+    sf::Vector2f velocity;
+    float speed;
+    float wanderTimer;    // seconds since the last change of direction
+    float wanderInterval; // seconds between changes of direction
+    std::uint32_t rng;    // per-enemy random state, so wandering does not depend on update order
+};
+
+struct EnemyHealth {
+    int current;
+    int max;
+};
+
+// Position along a shared PathTrack. Enemies without a track wander instead.
+struct EnemyPathCursor {
+    std::int32_t track;  // EnemyWorld::NO_TRACK when wandering
+    float distance;      // world units along the track
+    float speed;
+    sf::Vector2f offset; // added to the track position, e.g. to fly in formation on one track
+    bool finished;       // reached the end of a non-looping track
+};
+
+struct EnemyAnimation {
+    float timer;
+    std::uint8_t frame;
+};
+
+// Which of EnemyWorld's per-type pattern arrays a shooter fires from
+enum class PatternKind : std::uint8_t {
+    None, // unarmed
+    DirectAtPlayer,
+    Radial,
+    Spread,
+    Scripted
+};
+
+struct EnemyShooter {
+    PatternKind kind;
+    std::int32_t pattern; // index into the array for `kind`
+    float timer;          // seconds since the last volley
+    float interval;       // copied from the pattern so the reload check never touches it
+};
+
+// Fixed-capacity entity store for every enemy in the game, with one dense array per component.
+// - Each system (path, wander, animation, shooter) is a single linear pass over the arrays it needs
+// - Tracks and shooting patterns are shared and referenced by index, so an enemy owns no heap memory
+// - Patterns live in one array per type; reloaded shooters are fired type by type with direct calls
+// - Removal swaps the last enemy into the hole; EnemyIds survive it (slot -> dense index indirection)
+class EnemyWorld {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 8192;
+    static constexpr std::int32_t NO_TRACK = -1;
+    static constexpr std::int32_t NO_PATTERN = -1;
+    static const std::uint32_t DEFAULT_SEED = 1;
+
+    explicit EnemyWorld(std::size_t capacity = DEFAULT_CAPACITY);
+
+    // Shared data. Returns the index to pass to setTrack() / setPattern().
+    std::int32_t addTrack(std::shared_ptr<const PathTrack> track);
+    std::int32_t addPattern(ShootingPattern pattern);
+
+    // Restart the random sequence spawn() draws headings, wander timing and per-enemy states from.
+    // The same seed and the same calls give the same enemies.
+    void setSeed(std::uint32_t seed);
+    // New enemy heading in a random direction. Returns an invalid id when the world is full.
+    EnemyId spawn(float x, float y, float speed = 100.0f, int health = 1);
+    // Follow a track from `startDistance` along it, at `offset` from it; velocity no longer applies.
+    // The enemy is placed on the track right away.
+    void setTrack(EnemyId id, std::int32_t track, float speed, float startDistance = 0.0f,
+                  sf::Vector2f offset = sf::Vector2f(0.f, 0.f));
+    void setPattern(EnemyId id, std::int32_t pattern);
+
+    // Swap-and-pop removal by dense index. The enemy previously at size()-1 now lives at `index`.
+    void remove(std::size_t index);
+    bool remove(EnemyId id);
+    // Remove every enemy whose health reached zero
+    void removeDead();
+    // Remove enemies that reached the end of an open track off screen: they have left the stage
+    void removeDeparted(int screenWidth, int screenHeight);
+    void clear();
+
+    bool isAlive(EnemyId id) const;
+    // Dense index of a live id, or size() when the id is stale
+    std::size_t indexOf(EnemyId id) const;
+    EnemyId idAt(std::size_t index) const;
+
+    // Run every system once: movement (path or wander), animation, then shooting.
+    // Shots go into `spawns` block by block (SHOOTER_BLOCK enemies from `begin`), within a block by pattern type,
+    // then dense index; dead enemies are not removed here.
+    void update(float deltaTime, int screenWidth, int screenHeight, const sf::Vector2f& playerPos,
+                ProjectileSpawnBatch& spawns) {
+        update(deltaTime, screenWidth, screenHeight, playerPos, spawns, 0, m_size);
+    }
+    // Same for dense indices [begin, end) only. Disjoint ranges may be updated concurrently,
+    // each with its own spawn batch.
+    void update(float deltaTime, int screenWidth, int screenHeight, const sf::Vector2f& playerPos,
+                ProjectileSpawnBatch& spawns, std::size_t begin, std::size_t end);
+
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+
+    // Per-enemy accessors by dense index (valid for [0, size()))
+    sf::Vector2f getPosition(std::size_t index) const { return m_transform[index].position; }
+    // Position blended between the previous and the current tick (alpha in [0,1])
+    sf::Vector2f getInterpolatedPosition(std::size_t index, float alpha) const {
+        const EnemyTransform& t = m_transform[index];
+        return t.previous + (t.position - t.previous) * alpha;
+    }
+    sf::FloatRect getBounds(std::size_t index) const;
+    // Box covering the hit box's whole path over the last update (broadphase for swept tests)
+    sf::FloatRect getSweptBounds(std::size_t index) const;
+    // Distance moved in the last update
+    sf::Vector2f getMotion(std::size_t index) const { return m_transform[index].position - m_transform[index].previous; }
+    int getHealth(std::size_t index) const { return m_health[index].current; }
+    void takeDamage(std::size_t index, int damage);
+    bool isDead(std::size_t index) const { return m_health[index].current <= 0; }
+    bool hasPath(std::size_t index) const;
+    int getFrame(std::size_t index) const { return m_animation[index].frame; }
+
+    // Shooters reloaded and fired per block of this many dense indices (ready lists live on the stack)
+    static constexpr std::size_t SHOOTER_BLOCK = 256;
+
+private:
+    // Where a pattern id points: its type's array and the index in it
+    struct PatternRef {
+        PatternKind kind;
+        std::int32_t index;
+        float interval;
+    };
+
+    // Systems, each over dense indices [begin, end)
+    void updatePaths(float deltaTime, std::size_t begin, std::size_t end);
+    void updateWander(float deltaTime, int screenWidth, int screenHeight, std::size_t begin, std::size_t end);
+    void updateAnimation(float deltaTime, std::size_t begin, std::size_t end);
+    void updateShooters(float deltaTime, const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns,
+                        std::size_t begin, std::size_t end);
+    // Fire the reloaded shooters at dense indices ready[0..count), all using patterns of one type
+    template <typename Pattern>
+    void fireReady(const std::vector<Pattern>& patterns, const std::uint32_t* ready, std::size_t count,
+                   const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns);
+
+    std::size_t m_capacity;
+    std::size_t m_size;
+
+    // Dense component arrays
+    std::vector<EnemyTransform> m_transform;
+    std::vector<EnemyMotion> m_motion;
+    std::vector<EnemyHealth> m_health;
+    std::vector<EnemyPathCursor> m_path;
+    std::vector<EnemyAnimation> m_animation;
+    std::vector<EnemyShooter> m_shooter;
+    std::vector<std::uint32_t> m_slotOf; // dense index -> slot
+
+    // Slot table backing the ids
+    std::vector<std::uint32_t> m_indexOf;    // slot -> dense index
+    std::vector<std::uint32_t> m_generation; // bumped every time a slot is freed
+    std::vector<std::uint32_t> m_freeSlots;  // stack of unused slots
+
+    std::uint32_t m_spawnRng; // random state spawn() draws from; never zero
+
+    // Shared data referenced by the components
+    std::vector<std::shared_ptr<const PathTrack>> m_tracks;
+    std::vector<PatternRef> m_patterns; // pattern id -> typed array
+    std::vector<DirectAtPlayerPattern> m_directPatterns;
+    std::vector<RadialPattern> m_radialPatterns;
+    std::vector<SpreadPattern> m_spreadPatterns;
+    std::vector<ScriptedPattern> m_scriptedPatterns;
+};
+
+#endif // ENEMY_WORLD_H
@@ -0,0 +1,33 @@
+#ifndef FLOOR_MESH_H
+#define FLOOR_MESH_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Isometric floor (grid lines + checkered tiles with outlines) baked once into a triangle mesh.
+// - Geometry is built around the floor origin; scrolling is a translation applied at draw time
+// - Uploaded to a static sf::VertexBuffer when the driver supports it, otherwise drawn from memory
+// - Built lazily on the first draw so the GPU buffer is created once a context exists
+class FloorMesh {
+public:
+    explicit FloorMesh(int gridSize);
+
+    // Draw the whole floor with its origin at `offset` (one draw call)
+    void draw(sf::RenderTarget& target, sf::Vector2f offset);
+
+    std::size_t getVertexCount() const { return m_vertices.size(); }
+
+private:
+    void build();
+    void appendLine(sf::Vector2f a, sf::Vector2f b, float thickness, sf::Color color);
+    void appendTile(int x, int y, sf::Color fill, sf::Color outline, float outlineThickness);
+    void appendTriangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color);
+
+    int m_gridSize;
+    bool m_built;
+    bool m_useBuffer;
+    std::vector<sf::Vertex> m_vertices;
+    sf::VertexBuffer m_buffer;
+};
+
+#endif // FLOOR_MESH_H
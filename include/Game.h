@@ -5,65 +5,133 @@
 #include <SFML/Audio.hpp>
 #include <vector>
 #include <memory>
-#include "Ship.h"
-#include "Projectile.h"
-#include "Enemy.h"
+#include "Simulation.h"
+#include "JobSystem.h"
+#include "PlayfieldRenderer.h"
+#include "AssetCache.h"
+#include "AssetLoader.h"
+#include "HudLayer.h"
+#include "InputRecording.h"
+#include "InputLatency.h"
+#include "SoundBank.h"
+#include "SfxMixer.h"
+#include "SfxStream.h"
+#include "Profiler.h"
+#if SHMUP_PROFILING
+#include "ProfilerOverlay.h"
+#endif
 
+// Windowed front-end: owns the window, audio and rendering, and drives a Simulation from real input.
 class Game {
 public:
-    Game();
+    // tickRate: fixed simulation steps per second, independent of the display refresh rate.
+    // levelFile: level to play (compiled or text); the default enemy formation if it cannot be loaded.
+    // recordFile: where the session's input recording is written when the game ends ("" = not saved).
+    // replay: play this recording back instead of live input; its seed and tick length override the others.
+    // lateLatch: poll input again right before each render (see latchLateInput()); F4 toggles it.
+    explicit Game(float tickRate = DEFAULT_TICK_RATE, const std::string& levelFile = DEFAULT_LEVEL_PATH,
+                  const std::string& recordFile = std::string(), const InputRecording* replay = nullptr,
+                  bool lateLatch = false);
     ~Game();
     
     void run();
+
+    static constexpr float DEFAULT_TICK_RATE = 120.0f;
+    static const std::string DEFAULT_LEVEL_PATH;
+    static const std::string DEFAULT_RECORD_PATH;
     
 private:
+    // Show the loading screen until the background loads finish, then hand out the assets.
+    // False if the window was closed meanwhile.
+    bool waitForAssets();
     void processEvents();
+    // Late latch, between the frame's ticks and its render: poll the events that came in meanwhile (keys reach
+    // the simulation at its next tick, as usual) and re-sample the aim for the render snapshot, so the ship
+    // faces where the cursor is now rather than where it was at the last tick
+    void latchLateInput();
+    // Mouse cursor in playfield (world) coordinates
+    sf::Vector2f mouseTarget() const;
+    // Pass a key to the simulation, recording it (ignored while replaying)
+    void sendKey(sf::Keyboard::Key key, bool isPressed);
     void update(float deltaTime);
-    void render();
+    // alpha: how far the frame is between the previous and the current tick, in [0,1)
+    void render(float alpha);
+    // Place the upscaled playfield and the side panels in a window of this size
+    void updateLayout(sf::Vector2u windowSize);
     
     // Window
     sf::RenderWindow window;
     // Size of the in-game play area (classic 16-bit feel). Use SNES-like resolution.
-    // We'll default to 320x224 (width x height).
-    static const int PLAY_WIDTH = 320;
-    static const int PLAY_HEIGHT = 224;
-    // Make the window an integer scale of the retro play area so borders are small.
-    // Default to 2x scale of 320x224 -> 640x448 which is close to classic CRT sizes.
-    static const int WINDOW_WIDTH = PLAY_WIDTH * 2; // 640
-    static const int WINDOW_HEIGHT = PLAY_HEIGHT * 2; // 448
+    // The playfield is rendered at exactly this size; the simulation world is mapped onto it.
+    static const int PLAY_WIDTH = PlayfieldRenderer::NATIVE_WIDTH;   // 320
+    static const int PLAY_HEIGHT = PlayfieldRenderer::NATIVE_HEIGHT; // 224
+    // Default window: the play area at 3x with room for the side panels.
+    // Any size works; the playfield takes the largest integer scale that fits.
+    static const int WINDOW_WIDTH = 1280;
+    static const int WINDOW_HEIGHT = 720;
     static const std::string WINDOW_TITLE;
     
-    // Game objects
-    Ship playerShip;
-    std::vector<std::unique_ptr<Projectile>> projectiles;
-    std::vector<std::unique_ptr<Enemy>> enemies;
-    
-    // Collision detection
-    void checkCollisions();
-    
-    // Floor/Grid rendering
-    void drawFloor(sf::RenderWindow& window);
-    static const int FLOOR_GRID_SIZE = 20; // Grid cells across the floor
-    float backgroundScrollX; // Offset for scrolling background (wraps between 0 and TILE_WIDTH)
-    float backgroundScrollY; // Offset for scrolling background (wraps between 0 and TILE_HEIGHT)
-    static constexpr float SCROLL_SPEED = 240.0f; // Pixels per second for background scroll
+    // Every sprite sheet, packed into shared atlas textures (declared first: sprites point into it)
+    AssetCache assets;
+
+    // Worker threads for the simulation's parallel phases (declared before the simulation that uses them)
+    JobSystem jobs;
+
+    // Game world and logic
+    Simulation simulation;
+
+    // Low-resolution playfield, blitted to the window at an integer scale
+    PlayfieldRenderer playfield;
+    int playScale;          // window pixels per playfield pixel
+    sf::Vector2f playOrigin; // top-left of the upscaled playfield in the window
+    float sideWidth;        // width of each side panel
     
-    // Timing
+    // Timing: fixed-step simulation fed by an accumulator of real frame time
     sf::Clock clock;
-    float deltaTime;
-    float elapsedTime; // seconds since game start
+    float deltaTime;   // real time of the last frame
+    float tickLength;  // seconds per simulation step
+    float accumulator; // real time not yet consumed by simulation steps
+    // Most steps run in one frame; after a long hitch the rest of the backlog is dropped
+    static const int MAX_STEPS_PER_FRAME = 8;
+
+    // Input recording of this session, or the recording being replayed
+    InputRecording recording;
+    std::string recordPath;
+    bool replaying;
+    std::size_t replayCursor; // next recorded event to apply
+
+    // Input-to-present latency of live input, and the late latch that shortens it
+    InputLatency inputLatency;
+    bool lateLatch;
+    sf::Vector2f lateAim; // aim latched for this frame's render
+    bool hasLateAim;
+
+#if SHMUP_PROFILING
+    // Per-phase frame timings and their overlay (F3)
+    Profiler profiler;
+    ProfilerOverlay profilerOverlay;
+    std::uint32_t framePairTests; // summed over the frame's simulation steps
+#endif
 
     // UI
     sf::Font uiFont;
     bool uiHasFont;
+    HudLayer hud; // retained HUD, re-rendered only where its values change
     // Music
     sf::Music backgroundMusic;
     bool musicLoaded;
+    // Sound effects, mixed on the stream's thread. Created once the bank has loaded; the stream is declared
+    // last of the three so it stops before the mixer and bank it reads go away.
+    SoundBank soundBank;
+    std::unique_ptr<SfxMixer> sfx;
+    std::unique_ptr<SfxStream> sfxStream;
+    static constexpr float SFX_VOLUME = 0.6f;
     
     // Game state
     bool isRunning;
-    int currentLevel;
+
+    // Startup loads in flight (declared last so it stops before the font, music, sounds and cache it fills are destroyed)
+    std::unique_ptr<AssetLoader> loader;
 };
 
 #endif // GAME_H
-
@@ -0,0 +1,65 @@
+#ifndef HUD_LAYER_H
+#define HUD_LAYER_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+
+// Values the HUD shows; a part is re-rendered only when its inputs change
+struct HudState {
+    int health = 0;
+    int maxHealth = 20;
+    bool groundMode = false;
+    int seconds = 0; // whole seconds of play time
+    int level = 1;
+
+    bool operator==(const HudState& other) const;
+};
+
+// Retained HUD: HP stack, mode label, weapon slots, top bar with time and level.
+// - Everything is rendered into one window-sized RenderTexture and composited with a single sprite draw
+// - update() re-renders only the parts whose inputs changed (HP, mode, time, level); frames where
+//   nothing changed cost one quad
+// - Layout changes (e.g. a new window size) or a new font redraw everything
+class HudLayer {
+public:
+    static constexpr float TOP_BAR_HEIGHT = 28.0f;
+
+    HudLayer();
+
+    // Screen-space layout of the panels around the playfield
+    void setLayout(sf::Vector2u windowSize, float playLeft, float playRight, float sideWidth);
+    // May be null: the HUD is then drawn without labels
+    void setFont(const sf::Font* font);
+
+    void update(const HudState& state);
+    void draw(sf::RenderTarget& target) const;
+
+    // Parts re-rendered since construction (for profiling)
+    std::size_t getRedrawCount() const { return redrawCount; }
+
+private:
+    void redrawAll();
+    void drawHealth();
+    void drawMode();
+    void drawWeapons();
+    void drawTime();
+    void drawLevel();
+    // Overwrite a rect with a flat color (alpha included) before redrawing what it holds
+    void fillRegion(const sf::FloatRect& region, sf::Color color);
+
+    sf::RenderTexture canvas;
+    bool canvasReady;
+    const sf::Font* font;
+
+    sf::Vector2u size;
+    float playLeft;
+    float playRight;
+    float sideWidth;
+    bool layoutDirty;
+
+    HudState shown; // what the canvas currently holds
+    HudState pending;
+    std::size_t redrawCount;
+};
+
+#endif // HUD_LAYER_H
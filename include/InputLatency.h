@@ -0,0 +1,69 @@
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Input-to-present latency. Each input event is stamped when the front-end polls it, carried along until the
+// state it changed is in a frame, and measured when that frame has been presented.
+// - received(): an event arrived (stamped now)
+// - consumed(): the state the next present shows has taken in every event of these kinds received so far
+//   (a simulation tick takes keys and aim; a late-latched render snapshot takes aim only)
+// - presented(): the frame is on its way to the screen; every consumed event becomes a latency sample
+// Pending events and samples live in fixed rings, so none of this allocates after construction.
+class InputLatency {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Kind : std::uint8_t {
+        Key = 1, // key presses and releases: movement, fire, mode
+        Aim = 2, // mouse motion while the ship aims at the cursor
+    };
+
+    // Events waiting for a present; past this the oldest are dropped unmeasured
+    static constexpr std::size_t MAX_PENDING = 512;
+    // Latest samples the percentiles are taken over
+    static constexpr std::size_t SAMPLE_CAPACITY = 2048;
+
+    struct Summary {
+        std::size_t samples = 0; // in the window the percentiles cover
+        float p50Ms = 0.0f;
+        float p95Ms = 0.0f;
+        float p99Ms = 0.0f;
+        float maxMs = 0.0f;
+    };
+
+    InputLatency();
+
+    void received(Kind kind, Clock::time_point when = Clock::now());
+    // kinds: a mask of Kind values
+    void consumed(std::uint8_t kinds);
+    void presented(Clock::time_point when = Clock::now());
+
+    // Percentiles over the latest SAMPLE_CAPACITY samples
+    Summary summarize() const;
+    // Samples taken since construction
+    std::uint64_t getSampleCount() const { return sampleCount; }
+    // Events dropped because too many were pending
+    std::uint64_t getDroppedCount() const { return dropped; }
+
+private:
+    struct Pending {
+        Clock::time_point when;
+        Kind kind;
+        bool consumed;
+    };
+
+    std::array<Pending, MAX_PENDING> pending;
+    std::size_t pendingHead;  // oldest
+    std::size_t pendingCount;
+    std::vector<float> samplesMs; // ring of SAMPLE_CAPACITY
+    std::uint64_t sampleCount;
+    std::uint64_t dropped;
+    mutable std::vector<float> sorted; // summarize() scratch
+};
+
+#endif // INPUT_LATENCY_H
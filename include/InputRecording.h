@@ -0,0 +1,70 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Simulation;
+
+// One input change, applied just before the simulation tick it was recorded at
+struct InputEvent {
+    enum class Type : std::uint8_t { KeyDown, KeyUp, Aim };
+
+    std::uint32_t tick;
+    Type type;
+    sf::Keyboard::Key key; // KeyDown / KeyUp
+    sf::Vector2f aim;      // Aim: world-space target
+};
+
+// Everything needed to re-run a session: the seed, the tick length, which level was played and the input the
+// simulation saw, by tick.
+// - Game records into one while playing; --replay feeds it back at the same ticks
+// - The level file itself is not stored, only its content hash, so a replay can refuse a different level
+// - The simulation is deterministic, so a replay ends in the same state windowed or headless, at any speed
+// - Files are small: a fixed header, then about three bytes per key press or release
+class InputRecording {
+public:
+    static constexpr std::uint8_t FILE_VERSION = 2;
+
+    InputRecording();
+
+    // Drop any events and start a new session
+    void begin(std::uint32_t seed, float tickLength);
+    void recordKey(std::uint32_t tick, sf::Keyboard::Key key, bool isPressed);
+    // Aim targets are recorded only when they change
+    void recordAim(std::uint32_t tick, const sf::Vector2f& target);
+    // Level the session plays (Simulation::getLevelHash())
+    void setLevelHash(std::uint64_t hash) { levelHash = hash; }
+    // Length of the session in ticks (a replay runs exactly this many)
+    void setTickCount(std::uint32_t ticks) { tickCount = ticks; }
+
+    // Feed the simulation every event recorded for its next tick. `cursor` is the first event not yet
+    // applied: start at 0 and pass the same variable before every tick.
+    void apply(Simulation& simulation, std::size_t& cursor) const;
+
+    bool saveToFile(const std::string& path) const;
+    // False (and the recording left empty) if the file is missing, truncated or not a recording
+    bool loadFromFile(const std::string& path);
+
+    std::uint32_t getSeed() const { return seed; }
+    float getTickLength() const { return tickLength; }
+    std::uint64_t getLevelHash() const { return levelHash; }
+    std::uint32_t getTickCount() const { return tickCount; }
+    const std::vector<InputEvent>& getEvents() const { return events; }
+
+private:
+    std::uint32_t seed;
+    float tickLength;
+    std::uint64_t levelHash;
+    std::uint32_t tickCount;
+    std::vector<InputEvent> events; // in tick order
+
+    // Last recorded aim, to skip repeats of the same mouse position
+    bool hasLastAim;
+    sf::Vector2f lastAim;
+};
+
+#endif // INPUT_RECORDING_H
@@ -0,0 +1,88 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Small work-stealing thread pool built around one primitive, parallelFor().
+// - Each thread (the caller included) gets a contiguous share of the chunks in its own queue,
+//   works through it front to back and steals from the back of other queues once it runs dry
+// - Chunk boundaries depend only on the count and grain, never on the thread count, so callers
+//   that keep one output buffer per chunk and merge them in chunk order get the serial result
+// - With zero workers every chunk runs on the calling thread, in order
+class JobSystem {
+public:
+    // `workerCount` threads in addition to the caller
+    explicit JobSystem(std::size_t workerCount = defaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // One worker per hardware thread, minus the caller
+    static std::size_t defaultWorkerCount();
+
+    // Threads taking part in parallelFor(), the caller included
+    std::size_t getThreadCount() const { return queues.size(); }
+
+    // Split [0, count) into chunks of `grain` items and call fn(begin, end, thread) for each one,
+    // where thread in [0, getThreadCount()) identifies the running thread (0 = the caller).
+    // Returns once every chunk has finished. fn must not call parallelFor() itself.
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t grain, Fn&& fn);
+
+    // Number of chunks parallelFor() makes of `count` items
+    static std::size_t chunkCount(std::size_t count, std::size_t grain) {
+        return grain == 0 ? 0 : (count + grain - 1) / grain;
+    }
+
+private:
+    using ChunkFn = void (*)(void* context, std::size_t begin, std::size_t end, std::size_t thread);
+
+    struct Chunk {
+        ChunkFn fn;
+        void* context;
+        std::size_t begin;
+        std::size_t end;
+        std::atomic<std::size_t>* pending; // decremented when the chunk is done
+    };
+
+    // Per-thread queue. The owner takes from the front, thieves from the back.
+    struct Queue {
+        std::mutex mutex;
+        std::vector<Chunk> chunks;
+        std::size_t head = 0;
+    };
+
+    void run(std::size_t count, std::size_t grain, ChunkFn fn, void* context);
+    // Run one chunk from our own queue or another thread's. False when every queue is empty.
+    bool runOne(std::size_t thread);
+    bool pop(std::size_t queue, Chunk& out, bool steal);
+    void workerLoop(std::size_t thread);
+
+    std::vector<std::unique_ptr<Queue>> queues; // [0] belongs to the caller of parallelFor()
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::uint64_t generation; // bumped every time work is posted
+    bool stopping;
+};
+
+template <typename Fn>
+void JobSystem::parallelFor(std::size_t count, std::size_t grain, Fn&& fn) {
+    using Callable = typename std::remove_reference<Fn>::type;
+    ChunkFn thunk = [](void* context, std::size_t begin, std::size_t end, std::size_t thread) {
+        (*static_cast<Callable*>(context))(begin, end, thread);
+    };
+    run(count, grain, thunk, const_cast<void*>(static_cast<const void*>(&fn)));
+}
+
+#endif // JOB_SYSTEM_H
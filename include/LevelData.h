@@ -0,0 +1,151 @@
+#ifndef LEVEL_DATA_H
+#define LEVEL_DATA_H
+
+#include "BulletScript.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compiled level layout. A file is one header followed by seven flat arrays at the offsets it gives,
+// with no pointers and every field 4-byte aligned, so the file can be mapped and used where it lies.
+// Multi-byte fields are little-endian.
+namespace LevelFormat {
+    static const char MAGIC[4] = {'S', 'H', 'L', 'V'};
+    static const std::uint32_t VERSION = 2;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::int32_t level; // number shown in the HUD
+        std::uint32_t trackCount;
+        std::uint32_t pointCount;
+        std::uint32_t patternCount;
+        std::uint32_t spawnCount;
+        std::uint32_t tracksOffset; // byte offsets from the start of the file
+        std::uint32_t pointsOffset;
+        std::uint32_t patternsOffset;
+        std::uint32_t spawnsOffset;
+        std::uint32_t totalSize;
+        // Bullet scripts, as a BulletProgram: instructions, actions, and the top action of each script
+        std::uint32_t instructionCount;
+        std::uint32_t actionCount;
+        std::uint32_t scriptCount;
+        std::uint32_t instructionsOffset;
+        std::uint32_t actionsOffset;
+        std::uint32_t scriptsOffset;
+    };
+
+    // Waypoints [firstPoint, firstPoint + pointCount) of the points array
+    struct Track {
+        std::uint32_t firstPoint;
+        std::uint32_t pointCount;
+        std::uint32_t catmullRom; // 0 = polyline
+        std::uint32_t loop;
+    };
+
+    struct Point {
+        float x;
+        float y;
+    };
+
+    enum PatternKind : std::uint32_t { Aimed = 0, Radial = 1, Spread = 2, Script = 3 };
+
+    struct Pattern {
+        std::uint32_t kind;   // PatternKind
+        std::int32_t count;   // radial / spread: shots per volley; script: index into the scripts
+        float interval;       // seconds between volleys
+        float speed;          // projectile speed
+        float range;          // aimed: only fire at a player this close
+        float arcDegrees;     // spread: fan width
+        std::uint32_t always; // aimed: fire even out of range
+    };
+
+    // One enemy entering the stage. The spawn array is sorted by time.
+    struct Spawn {
+        float time;          // stage clock, seconds
+        float x;             // position; with a track, the offset from it
+        float y;
+        float speed;
+        std::int32_t health;
+        std::int32_t track;  // index into the tracks, or -1 to wander
+        float trackSpeed;
+        float trackDistance; // where along the track it starts (negative = still behind the start)
+        std::int32_t pattern; // index into the patterns, or -1 to hold fire
+    };
+
+    static_assert(sizeof(Header) == 72, "level header layout changed");
+    static_assert(sizeof(Track) == 16 && sizeof(Point) == 8 && sizeof(Pattern) == 28 && sizeof(Spawn) == 36,
+                  "level record layout changed");
+}
+
+// Text level source to the compiled layout above. Waves are expanded into one spawn per enemy and sorted by time.
+// On failure returns false and describes the first bad line in `error`.
+//
+// Source format, one directive per line ('#' starts a comment, coordinates are world units):
+//   level <number>
+//   track <name> polyline|catmullrom loop|open <x> <y> <x> <y> ...
+//   pattern <name> aimed <interval> <speed> <range> [always]
+//   pattern <name> radial <count> <interval> <speed>
+//   pattern <name> spread <count> <arcDegrees> <interval> <speed>
+//   pattern <name> script <interval> <file>     bullet script (see BulletScript.h), compiled into the level
+//   archetype <name> [speed=S] [health=H] [pattern=P]
+//   wave <time> <archetype> [key=value ...]
+// Wave keys: count (members, default 1), delay (seconds between members), x y (first member's position, or its
+// offset from the track), dx dy (formation offset between members), speed, health, pattern (override the
+// archetype), track, track_speed, distance (first member's start along the track), spacing (each later member
+// starts this much further back). Script files are looked up relative to `baseDirectory`.
+bool compileLevel(const std::string& source, std::vector<std::uint8_t>& out, std::string& error,
+                  const std::string& baseDirectory = "");
+
+// A compiled level, read-only. Compiled files are memory-mapped where the platform allows (read in one go
+// otherwise), so even a large stage costs nothing until its spawns are reached; text sources are compiled on load.
+class LevelData {
+public:
+    LevelData();
+    ~LevelData();
+    LevelData(const LevelData&) = delete;
+    LevelData& operator=(const LevelData&) = delete;
+
+    // A compiled file or a text source. False with a message in getError() if it cannot be used.
+    bool loadFromFile(const std::string& path);
+    // Compiled bytes (copied)
+    bool loadFromMemory(const std::vector<std::uint8_t>& bytes);
+    const std::string& getError() const { return error; }
+    // FNV-1a over the compiled bytes: the same for a text source and its compiled file, different for any edit
+    std::uint64_t contentHash() const;
+
+    int getLevelNumber() const { return header()->level; }
+    std::size_t getTrackCount() const { return header()->trackCount; }
+    std::size_t getPatternCount() const { return header()->patternCount; }
+    std::size_t getSpawnCount() const { return header()->spawnCount; }
+    const LevelFormat::Track& getTrack(std::size_t i) const { return records<LevelFormat::Track>(header()->tracksOffset)[i]; }
+    const LevelFormat::Point* getPoints() const { return records<LevelFormat::Point>(header()->pointsOffset); }
+    const LevelFormat::Pattern& getPattern(std::size_t i) const { return records<LevelFormat::Pattern>(header()->patternsOffset)[i]; }
+    const LevelFormat::Spawn& getSpawn(std::size_t i) const { return records<LevelFormat::Spawn>(header()->spawnsOffset)[i]; }
+    // Bullet scripts, in place (see BulletVM::setProgram)
+    std::size_t getInstructionCount() const { return header()->instructionCount; }
+    std::size_t getActionCount() const { return header()->actionCount; }
+    std::size_t getScriptCount() const { return header()->scriptCount; }
+    const BulletCode::Instruction* getInstructions() const { return records<BulletCode::Instruction>(header()->instructionsOffset); }
+    const BulletCode::Action* getActions() const { return records<BulletCode::Action>(header()->actionsOffset); }
+    const std::uint32_t* getScripts() const { return records<std::uint32_t>(header()->scriptsOffset); }
+
+private:
+    const LevelFormat::Header* header() const { return reinterpret_cast<const LevelFormat::Header*>(data); }
+    template <typename T>
+    const T* records(std::uint32_t offset) const { return reinterpret_cast<const T*>(data + offset); }
+
+    // Check the header and every index in the bytes at `data`
+    bool validate();
+    void release();
+
+    const std::uint8_t* data; // the compiled layout: mapped file, or buffer
+    std::size_t size;
+    std::vector<std::uint8_t> buffer;
+    void* mapping; // non-null while a file is mapped
+    std::size_t mappingSize;
+    std::string error;
+};
+
+#endif // LEVEL_DATA_H
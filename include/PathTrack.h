@@ -0,0 +1,60 @@
+#ifndef PATH_TRACK_H
+#define PATH_TRACK_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+// Immutable movement track, baked once and shared by any number of followers.
+// - Built from waypoints in world coordinates, joined by straight lines or a Catmull-Rom spline
+// - The curve is resampled at equal arc-length steps, so positionAt() is one table lookup and a lerp
+// - Followers keep only a distance along the track; moving at constant speed is just distance += speed * dt,
+//   and whatever is left over at a waypoint carries on past it
+class PathTrack {
+public:
+    enum class Shape { Polyline, CatmullRom };
+
+    static constexpr float DEFAULT_SPACING = 1.0f; // world units between table samples
+
+    PathTrack(const std::vector<sf::Vector2f>& waypoints, Shape shape = Shape::Polyline, bool loop = true,
+              float spacing = DEFAULT_SPACING);
+    // Same, from tile coordinates (tile centers)
+    static PathTrack fromTiles(const std::vector<sf::Vector2i>& tiles, Shape shape = Shape::Polyline, bool loop = true,
+                               float spacing = DEFAULT_SPACING);
+
+    // Position `distance` world units along the track. Looping tracks wrap around; others clamp to the ends.
+    sf::Vector2f positionAt(float distance) const {
+        distance = wrap(distance);
+        float u = distance * m_invStep;
+        if (u <= 0.0f) return m_samples.front();
+        std::size_t k = static_cast<std::size_t>(u);
+        if (k >= m_samples.size() - 1) return m_samples.back();
+        float t = u - static_cast<float>(k);
+        const sf::Vector2f& a = m_samples[k];
+        const sf::Vector2f& b = m_samples[k + 1];
+        return a + (b - a) * t;
+    }
+    // Bring a distance back into [0, length) on a looping track (unchanged otherwise)
+    float wrap(float distance) const {
+        if (!m_loop) return distance;
+        distance -= m_length * static_cast<float>(static_cast<long>(distance * m_invLength));
+        if (distance < 0.0f) distance += m_length;
+        if (distance >= m_length) distance -= m_length;
+        return distance;
+    }
+
+    float getLength() const { return m_length; }
+    bool isLooping() const { return m_loop; }
+    std::size_t getSampleCount() const { return m_samples.size(); }
+
+private:
+    // Equal arc-length samples of the curve: m_samples[k] lies k * m_step along it (k = 0 .. count)
+    std::vector<sf::Vector2f> m_samples;
+    float m_length;
+    float m_step;
+    float m_invStep;
+    float m_invLength;
+    bool m_loop;
+};
+
+#endif // PATH_TRACK_H
@@ -0,0 +1,51 @@
+#ifndef PLAYFIELD_RENDERER_H
+#define PLAYFIELD_RENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include "FloorMesh.h"
+#include "SpriteBatch.h"
+
+class Simulation;
+class Profiler;
+
+// Draws a Simulation into a fixed low-resolution render target. The whole world is mapped onto the target, so a
+// 320x224 target shows the 640x448 world at half scale without changing anything the simulation does.
+// - Fill and raster cost depend on the playfield size only, not on the window size
+// - The front-end scales the result up by an integer factor, so pixels stay square and sharp
+// - Needs no window: headless runs can render a frame and read it back with capture()
+class PlayfieldRenderer {
+public:
+    // Native playfield resolution (SNES-like)
+    static constexpr unsigned NATIVE_WIDTH = 320;
+    static constexpr unsigned NATIVE_HEIGHT = 224;
+
+    PlayfieldRenderer(unsigned width = NATIVE_WIDTH, unsigned height = NATIVE_HEIGHT);
+
+    // Render the world as of `alpha` between the previous and current tick. False if no target could be created.
+    // lateAim: aim sampled after the last tick, shown on the ship in place of the tick's (see Ship::draw())
+    bool render(const Simulation& simulation, float alpha, const sf::Vector2f* lateAim = nullptr);
+
+    // Result of the last render (valid once render() returned true)
+    const sf::Texture& getTexture() const { return target.getTexture(); }
+    // Copy of the last frame in CPU memory
+    sf::Image capture() const { return target.getTexture().copyToImage(); }
+
+    sf::Vector2u getSize() const { return size; }
+    // World units per target pixel, along each axis
+    sf::Vector2f getWorldScale() const;
+    // Report floor and sprite phase times to this profiler (nullptr = off)
+    void setProfiler(Profiler* p) { profiler = p; }
+    const SpriteBatch& getSpriteBatch() const { return spriteBatch; }
+
+private:
+    static const int FLOOR_GRID_SIZE = 20; // Grid cells across the floor
+
+    sf::Vector2u size;
+    sf::RenderTexture target;
+    bool targetReady;
+    FloorMesh floorMesh;     // baked once, scrolled with a transform
+    SpriteBatch spriteBatch; // projectile, enemy and ship quads, one draw call per atlas page
+    Profiler* profiler;
+};
+
+#endif // PLAYFIELD_RENDERER_H
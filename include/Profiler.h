@@ -0,0 +1,104 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Per-phase frame profiler. Build with SHMUP_PROFILING=0 to compile every timer out.
+#ifndef SHMUP_PROFILING
+#define SHMUP_PROFILING 1
+#endif
+
+// Phases of one frame, in the order they run
+enum class ProfilePhase : std::uint8_t {
+    Events,     // window event polling
+    Update,     // simulation: ship, projectiles, enemies
+    Projectiles,// part of Update: projectile integration and culling
+    Scripts,    // part of Update: bullet script VM
+    Collisions, // simulation: broadphase and narrow phase
+    Floor,      // floor mesh draw
+    Sprites,    // projectile/enemy batches and the ship
+    Hud,        // side panels, HP, weapon slots, timer
+    Display,    // window.display() (includes vsync wait)
+    Count
+};
+
+const char* profilePhaseName(ProfilePhase phase);
+
+// One recorded frame
+struct FrameProfile {
+    float frameMs = 0.0f;
+    std::array<float, static_cast<std::size_t>(ProfilePhase::Count)> phaseMs{};
+    std::uint32_t projectiles = 0;
+    std::uint32_t enemies = 0;
+    std::uint32_t pairTests = 0;   // collision narrow-phase tests, summed over the frame's ticks
+    std::uint32_t simSteps = 0;    // simulation ticks run this frame
+    std::uint32_t drawCallsSaved = 0; // sprite batching: draw calls avoided this frame
+};
+
+// Records the last CAPACITY frames in a single-writer ring buffer.
+// - The game thread writes; readers on any thread use readFrame() without locks
+// - Each slot carries a sequence number so a reader detects a slot overwritten mid-copy
+class Profiler {
+public:
+    static const std::size_t CAPACITY = 4096;
+
+    Profiler();
+
+    void beginFrame();
+    void addTime(ProfilePhase phase, double seconds);
+    void setCounters(std::uint32_t projectiles, std::uint32_t enemies, std::uint32_t pairTests,
+                     std::uint32_t simSteps, std::uint32_t drawCallsSaved = 0);
+    void endFrame();
+
+    // Number of frames recorded so far (may exceed CAPACITY)
+    std::uint64_t getFrameCount() const { return m_written.load(std::memory_order_acquire); }
+    // Copy a recorded frame; age 0 is the most recent. False if it is gone or being overwritten.
+    bool readFrame(std::size_t age, FrameProfile& out) const;
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0}; // frame number + 1 once written, 0 while writing
+        FrameProfile frame;
+    };
+
+    std::array<Slot, CAPACITY> m_ring;
+    std::atomic<std::uint64_t> m_written;
+    FrameProfile m_current;
+    std::chrono::steady_clock::time_point m_frameStart;
+};
+
+// Adds the time spent in its scope to a phase of the current frame (no-op for a null profiler)
+class ProfileScope {
+public:
+    ProfileScope(Profiler* profiler, ProfilePhase phase)
+        : m_profiler(profiler), m_phase(phase) {
+        if (m_profiler) m_start = std::chrono::steady_clock::now();
+    }
+    ~ProfileScope() {
+        if (m_profiler) {
+            m_profiler->addTime(m_phase, std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count());
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler* m_profiler;
+    ProfilePhase m_phase;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#define SHMUP_PROFILE_CONCAT_INNER(a, b) a##b
+#define SHMUP_PROFILE_CONCAT(a, b) SHMUP_PROFILE_CONCAT_INNER(a, b)
+#if SHMUP_PROFILING
+#define SHMUP_PROFILE_SCOPE(profilerPtr, phase) \
+    ProfileScope SHMUP_PROFILE_CONCAT(shmupProfileScope, __LINE__)((profilerPtr), (phase))
+#else
+#define SHMUP_PROFILE_SCOPE(profilerPtr, phase) ((void)0)
+#endif
+
+#endif // PROFILER_H
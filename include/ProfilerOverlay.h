@@ -0,0 +1,40 @@
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+
+#include <SFML/Graphics.hpp>
+#include "Profiler.h"
+#include "InputLatency.h"
+
+// Debug panel drawn over the HUD (toggle with F3).
+// - Frame-time graph of the last GRAPH_FRAMES frames, each column stacked by phase
+// - Per-phase bars averaged over the last AVERAGE_FRAMES frames, against a 60 Hz budget
+// - Live counters: projectiles, enemies, collision pair tests, draw calls saved
+// - Input-to-present latency percentiles, when given an InputLatency
+// All graph geometry goes into one reused vertex array, so drawing it does not allocate.
+class ProfilerOverlay {
+public:
+    static const int GRAPH_FRAMES = 180;
+    static const int AVERAGE_FRAMES = 30;
+    static constexpr float WIDTH = GRAPH_FRAMES + 12.0f;
+    static constexpr float BUDGET_MS = 1000.0f / 60.0f;
+
+    ProfilerOverlay();
+
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+
+    // Draw the panel with its top-left corner at `position` (screen coordinates).
+    // `font` may be null, in which case only the graph and bars are drawn.
+    void draw(sf::RenderTarget& target, const Profiler& profiler, sf::Vector2f position, const sf::Font* font,
+              const InputLatency* latency = nullptr);
+
+    static sf::Color phaseColor(ProfilePhase phase);
+
+private:
+    void addRect(float x, float y, float w, float h, sf::Color color);
+
+    sf::VertexArray quads;
+    bool visible;
+};
+
+#endif // PROFILER_OVERLAY_H
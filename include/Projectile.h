@@ -2,58 +2,50 @@
 #define PROJECTILE_H
 
 #include <SFML/Graphics.hpp>
-#include <memory>
+#include <cstdint>
 
+class ProjectilePool;
+class SpriteBatch;
+class AssetCache;
+struct SpriteAnimation;
+
+// Shared projectile definitions and rendering.
+// Per-projectile state lives in ProjectilePool; this class owns what all projectiles have in common.
 class Projectile {
 public:
-    enum class Owner { Player, Enemy };
-
-    // lifetime: seconds before auto-destroy (negative = use off-screen test)
-    // stretchToLength: if true, sprite will be stretched along X to a large length (useful for beams)
-    // preview: if true, rendering will be thin/semi-transparent to indicate a warning
-    Projectile(float x, float y, float angle, float speed = 500.0f, Owner owner = Owner::Player,
-               float lifetime = -1.0f, bool stretchToLength = false, bool preview = false);
-    
-    void update(float deltaTime);
-    void draw(sf::RenderWindow& window);
-    
-    sf::Vector2f getPosition() const;
-    bool isOffScreen(int screenWidth, int screenHeight) const;
-    sf::FloatRect getBounds() const;
-    bool checkCollision(const sf::FloatRect& otherBounds) const;
-    Owner getOwner() const;
-    
-    // Static texture management (shared across all projectiles)
-    static bool loadTexture();
+    enum class Owner : std::uint8_t { Player, Enemy };
+
+    // Animation cycle length; the frame rects come from the asset cache
+    static const int TOTAL_FRAMES = 6;
+    static constexpr float FRAME_DURATION = 0.05f; // 50ms per frame = 20 FPS animation
+    // Size of one sheet frame in pixels; also used as the unrotated hit box
+    static constexpr float FRAME_SIZE = 32.0f;
+    // The art's nose points to top-right; this offset aligns it with the travel direction
+    static constexpr float ROTATION_OFFSET_DEG = -135.0f;
+
+    // Queue every live projectile in the pool into the batch (one quad each).
+    // alpha blends between the previous and current tick positions.
+    static void draw(const ProjectilePool& pool, SpriteBatch& batch, float alpha = 1.0f);
+    // Same, with caller-provided animations (e.g. to batch without loading textures on a GPU)
+    static void draw(const ProjectilePool& pool, SpriteBatch& batch, const SpriteAnimation& playerShot,
+                     const SpriteAnimation& enemyShot, float alpha = 1.0f);
+
+    // Manual AABB intersection check (SFML 3 removed FloatRect::intersects helper in some configs)
+    static bool checkCollision(const sf::FloatRect& a, const sf::FloatRect& b);
+    // Swept version for boxes that moved in a straight line this tick: a and b are the current boxes, aMotion and
+    // bMotion how far each moved to get there. True if they overlapped at any moment of the tick (so fast shots
+    // cannot skip over a target between ticks); `time` is the first such moment, 0 = tick start, 1 = now.
+    static bool checkSweptCollision(const sf::FloatRect& a, const sf::Vector2f& aMotion,
+                                    const sf::FloatRect& b, const sf::Vector2f& bMotion, float& time);
+
+    // Look up the shot animations ("shot", "ufo_beam") in the cache, which must outlive the projectiles
+    static bool loadTexture(const AssetCache& assets);
     static void unloadTexture();
-    
+
 private:
-    sf::Vector2f position;
-    sf::Vector2f velocity;
-    float speed;
-    
-    // Animation textures (separate for player and enemy shots)
-    static std::unique_ptr<sf::Texture> texturePlayer;
-    static std::unique_ptr<sf::Texture> textureEnemy;
-    static const int FRAME_COLS = 2; // 2 columns in sprite sheet
-    static const int FRAME_ROWS = 3; // 3 rows in sprite sheet
-    static const int TOTAL_FRAMES = FRAME_COLS * FRAME_ROWS; // 6 frames total
-    
-    std::unique_ptr<sf::Sprite> sprite;
-    int currentFrame;
-    float animationTimer;
-    float frameDuration; // Time per frame in seconds
-    Owner owner;
-    // For beams / preview visuals
-    float lifetime; // seconds remaining; negative = not used
-    bool stretchToLength;
-    bool preview;
-    // When stretchToLength is true we render a RectangleShape beam instead of a stretched sprite
-    std::unique_ptr<sf::RectangleShape> beamShape;
-    
-    void updateAnimation(float deltaTime);
-    void updateSpriteRect();
+    // Animations inside the shared atlas (separate for player and enemy shots)
+    static const SpriteAnimation* animationPlayer;
+    static const SpriteAnimation* animationEnemy;
 };
 
 #endif // PROJECTILE_H
-
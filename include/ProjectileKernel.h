@@ -0,0 +1,56 @@
+#ifndef PROJECTILE_KERNEL_H
+#define PROJECTILE_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Arrays the integration kernel streams through, indexed by dense projectile index
+struct ProjectileStreams {
+    float* posX;
+    float* posY;
+    float* prevX;
+    float* prevY;
+    const float* velX;
+    const float* velY;
+    float* lifetime;    // seconds remaining; negative = not used
+    std::uint8_t* cull; // out: 1 = expired or outside the cull box
+};
+
+// Projectiles whose position leaves this box are culled
+struct CullBox {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+// Projectile integration over contiguous float arrays, with SSE2 and AVX2 versions picked at runtime.
+// - prev = pos, then pos += vel * dt
+// - A used lifetime (>= 0) counts down by dt and stops at exactly 0
+// - cull = lifetime is 0, or the new position lies outside the box
+// Every version does the same float operations in the same order (no FMA), so results are bit-identical.
+namespace ProjectileKernel {
+    enum class Isa { Scalar, SSE2, AVX2 };
+
+    using Fn = void (*)(const ProjectileStreams& streams, std::size_t begin, std::size_t end,
+                        float deltaTime, const CullBox& box);
+
+    // Reference version; also handles the tail of the vector versions
+    void integrateScalar(const ProjectileStreams& streams, std::size_t begin, std::size_t end,
+                         float deltaTime, const CullBox& box);
+
+    // Version for `isa`, or nullptr when this build or this CPU lacks it
+    Fn get(Isa isa);
+    // Widest version available here
+    Isa best();
+    const char* name(Isa isa);
+
+    // Run the version chosen by select() (best() until then)
+    void integrate(const ProjectileStreams& streams, std::size_t begin, std::size_t end,
+                   float deltaTime, const CullBox& box);
+    // Force a version, e.g. to compare them. False (and no change) if it is not available.
+    bool select(Isa isa);
+    Isa selected();
+}
+
+#endif // PROJECTILE_KERNEL_H
@@ -0,0 +1,177 @@
+#ifndef PROJECTILE_POOL_H
+#define PROJECTILE_POOL_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Projectile.h"
+
+// Generational reference to a projectile stored in a ProjectilePool.
+// A handle goes stale as soon as its projectile is removed, even if the slot is reused later.
+struct ProjectileHandle {
+    static constexpr std::uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+    std::uint32_t slot = INVALID_SLOT;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return slot != INVALID_SLOT; }
+};
+
+// Projectiles requested during a tick, waiting to be added to a ProjectilePool in one pass.
+// - Directions are unit vectors, so emitters never need trigonometry per bullet
+// - Storage is reserved up front and reused after clear(); it only grows past the reserve
+// - Scripted patterns add launches instead of shots, for the simulation's BulletVM to start
+class ProjectileSpawnBatch {
+public:
+    explicit ProjectileSpawnBatch(std::size_t reserve = DEFAULT_RESERVE);
+
+    static const std::size_t DEFAULT_RESERVE = 16384;
+
+    // Bullet script to start at a position
+    struct Launch {
+        std::int32_t script;
+        float x;
+        float y;
+    };
+
+    // (dirX, dirY) must be a unit vector
+    void emit(float x, float y, float dirX, float dirY, float speed,
+              Projectile::Owner owner = Projectile::Owner::Enemy, float lifetime = -1.0f) {
+        m_x.push_back(x);
+        m_y.push_back(y);
+        m_dirX.push_back(dirX);
+        m_dirY.push_back(dirY);
+        m_speed.push_back(speed);
+        m_lifetime.push_back(lifetime);
+        m_owner.push_back(owner);
+    }
+    void launch(std::int32_t script, float x, float y) { m_launches.push_back(Launch{script, x, y}); }
+    void reserve(std::size_t count);
+    void clear();
+
+    std::size_t size() const { return m_x.size(); }
+    bool empty() const { return m_x.empty() && m_launches.empty(); }
+    const std::vector<Launch>& getLaunches() const { return m_launches; }
+
+private:
+    friend class ProjectilePool;
+
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_dirX;
+    std::vector<float> m_dirY;
+    std::vector<float> m_speed;
+    std::vector<float> m_lifetime;
+    std::vector<Projectile::Owner> m_owner;
+    std::vector<Launch> m_launches;
+};
+
+// Fixed-capacity structure-of-arrays store for every live projectile in the game.
+// - All arrays are allocated once in the constructor; spawn() never touches the heap
+// - Live projectiles are packed densely in [0, size()); remove() swaps the last one into the hole
+// - Dense indices move on removal, handles do not (slot -> dense index indirection)
+class ProjectilePool {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 131072;
+
+    explicit ProjectilePool(std::size_t capacity = DEFAULT_CAPACITY);
+
+    // Spawn a projectile travelling along the unit vector (dirX, dirY). Returns an invalid handle when the pool is full.
+    // lifetime: seconds before auto-destroy (negative = rely on the off-screen test only)
+    ProjectileHandle spawnDirected(float x, float y, float dirX, float dirY, float speed = 500.0f,
+                                   Projectile::Owner owner = Projectile::Owner::Player, float lifetime = -1.0f);
+    // Same, travelling at `angle` (radians)
+    ProjectileHandle spawn(float x, float y, float angle, float speed = 500.0f,
+                           Projectile::Owner owner = Projectile::Owner::Player, float lifetime = -1.0f);
+    // Add every projectile of the batch, in order, until the pool is full. Returns how many were added.
+    // The batch's launches are not projectiles and are left to the caller.
+    std::size_t spawn(const ProjectileSpawnBatch& batch);
+    // New heading and speed for a live projectile (e.g. from a bullet script); its sprite turns to match
+    void steer(std::size_t index, float dirX, float dirY, float speed);
+
+    // Swap-and-pop removal by dense index. The projectile previously at size()-1 now lives at `index`.
+    void remove(std::size_t index);
+    bool remove(ProjectileHandle handle);
+    void clear();
+
+    bool isAlive(ProjectileHandle handle) const;
+    // Dense index of a live handle, or size() when the handle is stale
+    std::size_t indexOf(ProjectileHandle handle) const;
+    ProjectileHandle handleAt(std::size_t index) const;
+
+    // Integrate positions, advance animation frames and lifetimes for every live projectile, and flag the
+    // ones that left the screen (with margin) or whose lifetime ran out. Positions and lifetimes go through
+    // the vectorized ProjectileKernel. The positions from before the step are kept for render interpolation.
+    void update(float deltaTime, int screenWidth, int screenHeight) { update(deltaTime, screenWidth, screenHeight, 0, m_size); }
+    // Same for dense indices [begin, end) only; disjoint ranges may be updated concurrently
+    void update(float deltaTime, int screenWidth, int screenHeight, std::size_t begin, std::size_t end);
+    // Remove the projectiles flagged by the last update()
+    void removeCulled();
+
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == m_capacity; }
+
+    // Per-projectile accessors by dense index (valid for [0, size()))
+    sf::Vector2f getPosition(std::size_t index) const { return sf::Vector2f(m_posX[index], m_posY[index]); }
+    sf::Vector2f getPreviousPosition(std::size_t index) const { return sf::Vector2f(m_prevX[index], m_prevY[index]); }
+    // Position blended between the previous and the current tick (alpha in [0,1])
+    sf::Vector2f getInterpolatedPosition(std::size_t index, float alpha) const {
+        return sf::Vector2f(m_prevX[index] + (m_posX[index] - m_prevX[index]) * alpha,
+                            m_prevY[index] + (m_posY[index] - m_prevY[index]) * alpha);
+    }
+    sf::Vector2f getVelocity(std::size_t index) const { return sf::Vector2f(m_velX[index], m_velY[index]); }
+    Projectile::Owner getOwner(std::size_t index) const { return m_owner[index]; }
+    // Sprite rotation as (cos, sin); getRotation() converts it to degrees
+    sf::Vector2f getRotationVector(std::size_t index) const { return sf::Vector2f(m_rotCos[index], m_rotSin[index]); }
+    float getRotation(std::size_t index) const;
+    int getFrame(std::size_t index) const { return m_frame[index]; }
+    sf::FloatRect getBounds(std::size_t index) const;
+    // Box covering the hit box's whole path over the last update (broadphase for swept tests)
+    sf::FloatRect getSweptBounds(std::size_t index) const;
+    // Distance moved in the last update
+    sf::Vector2f getMotion(std::size_t index) const {
+        return sf::Vector2f(m_posX[index] - m_prevX[index], m_posY[index] - m_prevY[index]);
+    }
+    bool checkCollision(std::size_t index, const sf::FloatRect& otherBounds) const;
+
+    // Raw dense arrays for bulk passes over the pool
+    const float* positionsX() const { return m_posX.data(); }
+    const float* positionsY() const { return m_posY.data(); }
+
+private:
+    // Fill dense index i (already counted in m_size) and bind it to a free slot
+    std::uint32_t initialize(std::size_t i, float x, float y, float dirX, float dirY, float speed,
+                             Projectile::Owner owner, float lifetime);
+    // Sprite rotation and hit box of dense index i for travel along (dirX, dirY)
+    void orient(std::size_t i, float dirX, float dirY);
+
+    std::size_t m_capacity;
+    std::size_t m_size;
+
+    // Dense per-projectile arrays
+    std::vector<float> m_posX;
+    std::vector<float> m_posY;
+    std::vector<float> m_prevX;      // position before the last update (render interpolation)
+    std::vector<float> m_prevY;
+    std::vector<float> m_velX;
+    std::vector<float> m_velY;
+    std::vector<float> m_lifetime;   // seconds remaining; negative = not used
+    std::vector<float> m_animTimer;
+    std::vector<float> m_rotCos;     // sprite rotation as a unit vector (set at spawn and by steer())
+    std::vector<float> m_rotSin;
+    std::vector<float> m_halfExtent; // half size of the (rotated) hit box
+    std::vector<std::uint8_t> m_frame;
+    std::vector<std::uint8_t> m_cull; // set by update(): off screen or expired
+    std::vector<Projectile::Owner> m_owner;
+    std::vector<std::uint32_t> m_slotOf; // dense index -> slot
+
+    // Slot table backing the handles
+    std::vector<std::uint32_t> m_indexOf;    // slot -> dense index
+    std::vector<std::uint32_t> m_generation; // bumped every time a slot is freed
+    std::vector<std::uint32_t> m_freeSlots;  // stack of unused slots
+};
+
+#endif // PROJECTILE_POOL_H
@@ -0,0 +1,115 @@
+#ifndef SFX_MIXER_H
+#define SFX_MIXER_H
+
+#include "SoundBank.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Software mixer for sound effects: a fixed pool of voices mixed into one interleaved stereo stream.
+// - The game thread calls play() for each gameplay event and flush() once a frame. Plays of the same sound
+//   within a frame merge into one slightly louder trigger, so a 40-bullet volley takes one voice, not 40
+// - flush() hands the triggers over through a single-producer, single-consumer lock-free queue that
+//   render() drains on the audio thread; neither side ever waits for the other
+// - Voices and mix buffers are allocated once. With every voice busy, a new sound takes the voice of the
+//   lowest-priority sound playing (the oldest of those), or is dropped if everything playing outranks it
+// - render() depends only on the triggers it has been given, so it can fill a buffer offline (headless runs)
+//   exactly as it feeds the sound card through SfxStream
+class SfxMixer {
+public:
+    static constexpr std::size_t DEFAULT_VOICES = 32;
+    static constexpr unsigned DEFAULT_SAMPLE_RATE = 44100;
+    static constexpr unsigned CHANNELS = 2;
+    // Triggers in flight between flush() and render(). A frame sends at most one per sound.
+    static constexpr std::size_t QUEUE_CAPACITY = 256;
+
+    struct Stats {
+        std::uint32_t activeVoices = 0; // after the latest render()
+        std::uint32_t peakVoices = 0;
+        std::uint64_t started = 0;   // triggers that got a voice
+        std::uint64_t stolen = 0;    // of those, the ones that cut another sound off
+        std::uint64_t dropped = 0;   // triggers outranked by every playing voice, or sent while the queue was full
+        std::uint64_t coalesced = 0; // play() calls merged into an earlier one of the same frame
+    };
+
+    // The bank must outlive the mixer and stay unchanged while it exists
+    explicit SfxMixer(const SoundBank& bank, std::size_t voiceCount = DEFAULT_VOICES,
+                      unsigned sampleRate = DEFAULT_SAMPLE_RATE);
+
+    SfxMixer(const SfxMixer&) = delete;
+    SfxMixer& operator=(const SfxMixer&) = delete;
+
+    // Game thread
+    // Play a sound at the next flush(). volume in [0, 1], pan from -1 (left) to 1 (right), pitch as a playback
+    // speed factor. A higher priority may take the voice of a lower one.
+    void play(SoundBank::SoundId sound, float volume = 1.0f, float pan = 0.0f, float pitch = 1.0f,
+              std::uint8_t priority = 0);
+    // Send this frame's triggers to the mixer, in the order their sounds were first played
+    void flush();
+    void setMasterVolume(float volume) { masterVolume.store(volume, std::memory_order_relaxed); }
+    Stats getStats() const;
+
+    // Audio thread, or the caller when rendering offline
+    // Start the triggers flushed so far, then mix `frames` stereo frames into out (interleaved left, right)
+    void render(std::int16_t* out, std::size_t frames);
+
+    unsigned getSampleRate() const { return sampleRate; }
+    std::size_t getVoiceCount() const { return voices.size(); }
+
+private:
+    struct Trigger {
+        SoundBank::SoundId sound;
+        std::uint8_t priority;
+        std::uint16_t count; // plays merged into this trigger
+        float volume;
+        float pan;
+        float pitch;
+    };
+
+    struct Voice {
+        const SoundBank::Sound* sound; // nullptr while free
+        std::uint64_t position;        // in source samples, 32.32 fixed point
+        std::uint64_t step;            // per output frame, same format
+        float gainLeft;
+        float gainRight;
+        std::uint32_t serial;          // start order, so the oldest can be stolen
+        std::uint8_t priority;
+    };
+
+    // Frames mixed per pass over the voices
+    static constexpr std::size_t MIX_BLOCK = 256;
+
+    void start(const Trigger& trigger);
+    // Add up to `frames` frames of a voice into the mix; frees the voice when its sound ends
+    static void mixVoice(Voice& voice, float* mix, std::size_t frames);
+
+    const SoundBank& bank;
+    unsigned sampleRate;
+
+    // Game thread: the frame's trigger for each sound, and the sounds played so far in first-played order
+    std::vector<Trigger> pending;
+    std::vector<SoundBank::SoundId> pendingOrder;
+
+    // Ring of flushed triggers. Each index is written by one side only.
+    std::vector<Trigger> queue;
+    alignas(64) std::atomic<std::size_t> queueHead; // next to read (audio thread)
+    alignas(64) std::atomic<std::size_t> queueTail; // next to write (game thread)
+
+    // Audio thread
+    std::vector<Voice> voices;
+    std::vector<float> mixBuffer;
+    std::uint32_t nextSerial;
+
+    std::atomic<float> masterVolume;
+    // Written by the side that counts them, read by getStats()
+    std::atomic<std::uint32_t> activeVoices;
+    std::atomic<std::uint32_t> peakVoices;
+    std::atomic<std::uint64_t> started;
+    std::atomic<std::uint64_t> stolen;
+    std::atomic<std::uint64_t> dropped;      // audio thread
+    std::atomic<std::uint64_t> queueDropped; // game thread
+    std::atomic<std::uint64_t> coalesced;
+};
+
+#endif // SFX_MIXER_H
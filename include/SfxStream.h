@@ -0,0 +1,28 @@
+#ifndef SFX_STREAM_H
+#define SFX_STREAM_H
+
+#include <SFML/Audio.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SfxMixer.h"
+
+// Plays an SfxMixer through SFML: the stream's own thread asks the mixer for one short chunk at a time.
+// The mixer must outlive the stream.
+class SfxStream : public sf::SoundStream {
+public:
+    // About 12 ms at 44.1 kHz: short chunks keep the delay from a trigger to the speaker low
+    static constexpr std::size_t CHUNK_FRAMES = 512;
+
+    explicit SfxStream(SfxMixer& mixer);
+    ~SfxStream() override; // stops playback before the chunk buffer goes away
+
+private:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time) override {}
+
+    SfxMixer& mixer;
+    std::vector<std::int16_t> buffer;
+};
+
+#endif // SFX_STREAM_H
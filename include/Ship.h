@@ -2,7 +2,10 @@
 #define SHIP_H
 
 #include <SFML/Graphics.hpp>
-#include <memory>
+
+class SpriteBatch;
+class AssetCache;
+struct SpriteAnimation;
 
 class Ship {
 public:
@@ -11,7 +14,12 @@ public:
     void update(float deltaTime);
     void handleInput(const sf::Keyboard::Key& key, bool isPressed);
     void updateInput(); // Call this each frame to process current input state
-    void draw(sf::RenderWindow& window);
+    // Queue the ship into the batch; alpha blends between the previous and current tick positions.
+    // aim: in ground mode, face this point instead of the last tick's aim (input latched after the tick)
+    void draw(SpriteBatch& batch, float alpha = 1.0f, const sf::Vector2f* aim = nullptr) const;
+    // Look up the ship animations in the asset cache (which must outlive the ship).
+    // Without them the ship simulates but draws nothing.
+    bool loadTexture(const AssetCache& assets);
     
     sf::Vector2f getPosition() const;
     void setPosition(float x, float y);
@@ -26,6 +34,9 @@ public:
     int getHealth() const;
     void takeDamage(int amount);
     sf::FloatRect getBounds() const;
+    // Box covering the hit box's whole path over the last update, and the distance moved in it (swept tests)
+    sf::FloatRect getSweptBounds() const;
+    sf::Vector2f getMotion() const { return position - previousPosition; }
     // Mode: Air or Ground (placeholder for later gameplay logic)
     enum class Mode { Air, Ground };
     Mode getMode() const;
@@ -43,31 +54,28 @@ public:
 
     // For ground mode controls: update facing via input (IJKL keys or mouse)
     void handleAimInput(const sf::Keyboard::Key& key, bool isPressed);
-    void updateMouseAim(const sf::RenderWindow& window);
+    // Face toward a world-space point (e.g. the mouse cursor mapped into the playfield)
+    void updateAim(const sf::Vector2f& target);
     void setFacingFromAngle(float angle);
     Facing getFacing() const;
 
 private:
     sf::Vector2f position;
+    sf::Vector2f previousPosition; // position before the last update (render interpolation)
     sf::Vector2f velocity;
     float speed;
     
-    // Sprite representation
-    sf::Texture texture;
-    std::unique_ptr<sf::Sprite> sprite;
-    // Ground-mode sprite sheets (diagonal down, straight down, diagonal up)
-    sf::Texture groundTexDownDiag;
-    sf::Texture groundTexStraight;
-    sf::Texture groundTexUpDiag;
+    // Animations in the shared atlas: air mode, and ground mode (diagonal down, straight down, diagonal up)
+    const SpriteAnimation* airAnimation;
+    const SpriteAnimation* groundDownDiag;
+    const SpriteAnimation* groundStraight;
+    const SpriteAnimation* groundUpDiag;
 
     // Ground-mode animation state
     int groundCurrentFrame;
     float groundAnimTimer;
     float groundFrameDuration;
-    // Ground sprites are provided as 2 columns x 3 rows (each frame 32x32 in the assets)
-    static const int GROUND_FRAME_COLS = 2;
-    static const int GROUND_FRAME_ROWS = 3;
-    static const int GROUND_TOTAL_FRAMES = GROUND_FRAME_COLS * GROUND_FRAME_ROWS;
+    static const int GROUND_TOTAL_FRAMES = 6; // animation cycle length
 
     // Mode and facing
     Mode mode;
@@ -81,8 +89,8 @@ private:
     // Health
     int health;
     
-    // Helper to load texture
-    bool loadTexture();
+    // Hit box size; matches the 32x32 air sprite and ground frames
+    static constexpr float FRAME_SIZE = 32.0f;
     
     // Input state tracking
     bool moveUp;
@@ -2,27 +2,91 @@
 #define SHOOTING_PATTERN_H
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <variant>
 #include <vector>
-#include <memory>
 
-class Projectile;
+class ProjectileSpawnBatch;
 
-// Abstract base for enemy shooting behavior
-class ShootingPattern {
+// Enemy shooting behaviors: a closed set of plain value types, dispatched statically.
+// Patterns hold no per-enemy state: each enemy keeps its own reload timer in EnemyWorld,
+// so thousands of enemies can reference a handful of patterns. EnemyWorld stores each type
+// in an array of its own and fires every emitter of one type in a single loop.
+//
+// Each type provides:
+// - getInterval(): seconds between volleys
+// - fire(): called once an enemy's reload timer reaches the interval. Emits the volley into the batch, which the
+//   simulation adds to its pool in one pass after every enemy has updated. Returning false holds fire
+//   (e.g. target out of range): the timer keeps running, so the enemy fires as soon as it can.
+
+// Direct shot at the player every fireRate seconds. Optionally only when the player is within activeRadius.
+class DirectAtPlayerPattern {
+public:
+    DirectAtPlayerPattern(float fireRate = 1.0f, float projSpeed = 220.0f, float activeRadius = 400.0f, bool always = false);
+
+    float getInterval() const { return m_fireRate; }
+    bool fire(const sf::Vector2f& enemyPos, const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns) const;
+
+private:
+    float m_fireRate;
+    float m_projSpeed;
+    float m_activeRadiusSquared;
+    bool m_always;
+};
+
+// Radial burst: N projectiles evenly around every interval
+class RadialPattern {
+public:
+    RadialPattern(int count = 8, float interval = 2.0f, float projSpeed = 160.0f);
+
+    float getInterval() const { return m_interval; }
+    bool fire(const sf::Vector2f& enemyPos, const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns) const;
+
+private:
+    std::vector<sf::Vector2f> m_directions; // one unit vector per bullet, built once
+    float m_interval;
+    float m_projSpeed;
+};
+
+// Aimed fan: N shots spread over an arc centred on the player every interval.
+// The table holds each shot's rotation relative to the aim direction, so a volley costs one rsqrt.
+class SpreadPattern {
 public:
-    virtual ~ShootingPattern() = default;
+    SpreadPattern(int count = 5, float arcDegrees = 60.0f, float interval = 1.5f, float projSpeed = 200.0f);
+
+    float getInterval() const { return m_interval; }
+    bool fire(const sf::Vector2f& enemyPos, const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns) const;
 
-    // Called each frame; implementations may push new projectiles into the list
-    virtual void update(float deltaTime,
-                        const sf::Vector2f& enemyPos,
-                        const sf::Vector2f& playerPos,
-                        std::vector<std::unique_ptr<Projectile>>& projectiles) = 0;
+private:
+    std::vector<sf::Vector2f> m_offsets; // (cos, sin) of each shot's angle from the aim direction
+    float m_interval;
+    float m_projSpeed;
 };
 
-// Factory helpers (implemented in ShootingPattern.cpp)
-std::unique_ptr<ShootingPattern> makeDirectAtPlayerPattern(float fireRate = 1.0f, float projSpeed = 220.0f, float activeRadius = 400.0f, bool always = false);
-std::unique_ptr<ShootingPattern> makeRadialPattern(int count = 8, float interval = 2.0f, float projSpeed = 160.0f);
-// Lingering beam: shows a thin preview for warningDuration seconds, then fires a stretched beam for beamDuration seconds
+// Scripted barrage: every interval, starts a bullet script (an index into the simulation's BulletVM program)
+// from the enemy's position. The VM runs it from there and steers the bullets it fires.
+class ScriptedPattern {
+public:
+    ScriptedPattern(std::int32_t script = 0, float interval = 4.0f);
+
+    float getInterval() const { return m_interval; }
+    bool fire(const sf::Vector2f& enemyPos, const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns) const;
+
+private:
+    std::int32_t m_script;
+    float m_interval;
+};
+
+// Any one pattern, as handed to EnemyWorld::addPattern(). Adding a type means adding it here
+// and giving EnemyWorld an array and a fire loop for it.
+using ShootingPattern = std::variant<DirectAtPlayerPattern, RadialPattern, SpreadPattern, ScriptedPattern>;
+
+// Factory helpers
+ShootingPattern makeDirectAtPlayerPattern(float fireRate = 1.0f, float projSpeed = 220.0f, float activeRadius = 400.0f, bool always = false);
+ShootingPattern makeRadialPattern(int count = 8, float interval = 2.0f, float projSpeed = 160.0f);
+// Fan of `count` shots spread evenly over arcDegrees, centred on the player
+ShootingPattern makeSpreadPattern(int count = 5, float arcDegrees = 60.0f, float interval = 1.5f, float projSpeed = 200.0f);
+ShootingPattern makeScriptedPattern(std::int32_t script, float interval = 4.0f);
 // (Lingering-beam pattern removed)
 
 #endif // SHOOTING_PATTERN_H
@@ -0,0 +1,168 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include "Ship.h"
+#include "Projectile.h"
+#include "ProjectilePool.h"
+#include "EnemyWorld.h"
+#include "SpatialHash.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "LevelData.h"
+#include "WaveSpawner.h"
+#include "BulletVM.h"
+
+// The game world and its per-tick logic, with no window, textures or audio.
+// - Game drives it from real input and draws its state; a headless driver can tick it directly
+// - Input arrives as key events and an optional aim target in world coordinates
+// - Nothing here needs a display, so it runs on build machines and faster than real time
+// - Deterministic: the same seed, tick lengths and input per tick give the same world, which is what
+//   input recordings rely on
+class Simulation {
+public:
+    // Size of the space entities move in. The front-end maps it onto the 320x224 playfield.
+    static const int WORLD_WIDTH = 640;
+    static const int WORLD_HEIGHT = 448;
+
+    // What happened during one update(), for feedback that lives outside the world (sound effects)
+    struct TickEvents {
+        std::uint32_t playerShots = 0;
+        std::uint32_t enemyShots = 0; // bullets fired by enemy patterns, plus one per scripted barrage started
+        std::uint32_t enemyHits = 0;  // player shots that hit an enemy
+        std::uint32_t enemiesDestroyed = 0;
+        std::uint32_t playerHits = 0;
+    };
+
+    explicit Simulation(std::size_t projectileCapacity = ProjectilePool::DEFAULT_CAPACITY);
+
+    // Seed for everything random in the world (call before spawning)
+    void setSeed(std::uint32_t seed);
+    std::uint32_t getSeed() const { return seed; }
+
+    // Play a level: its number becomes the current level, its bullet scripts become the VM's program, and its
+    // enemies enter as the stage clock reaches their spawn times (those at time 0 right away)
+    void setLevel(std::shared_ptr<const LevelData> level);
+    // Load a level file (compiled or text) and play it. On failure the world is left as it was
+    // and `error` says why.
+    bool loadLevel(const std::string& path, std::string& error);
+    const WaveSpawner& getSpawner() const { return spawner; }
+    // Populate the world with the default enemy formation (used when no level file is available)
+    void spawnDefaultEnemies();
+
+    // Report update/projectile/collision phase times to this profiler (nullptr = off)
+    void setProfiler(Profiler* p) { profiler = p; }
+    // Run projectile integration, enemy updates and the projectile-enemy narrow phase on this pool
+    // (nullptr = everything on the calling thread). The results do not depend on the thread count.
+    void setJobSystem(JobSystem* jobSystem);
+
+    // Input
+    void handleKey(sf::Keyboard::Key key, bool isPressed);
+    // World-space point the ship aims at in ground mode (e.g. the mouse cursor)
+    void setAimTarget(const sf::Vector2f& target);
+
+    // Advance the world by deltaTime seconds
+    void update(float deltaTime);
+
+    // State
+    const Ship& getShip() const { return playerShip; }
+    Ship& getShip() { return playerShip; }
+    const ProjectilePool& getProjectiles() const { return projectiles; }
+    ProjectilePool& getProjectiles() { return projectiles; }
+    const EnemyWorld& getEnemies() const { return enemies; }
+    EnemyWorld& getEnemies() { return enemies; }
+    // Runs the scripted patterns; a level sets its program, or set one directly for patterns added by hand
+    const BulletVM& getBullets() const { return bullets; }
+    BulletVM& getBullets() { return bullets; }
+    // Background scroll blended between the previous and current tick (alpha in [0,1])
+    sf::Vector2f getBackgroundScroll(float alpha = 1.0f) const;
+    float getElapsedTime() const { return elapsedTime; }
+    // Number of update() calls so far; input recordings are keyed by it
+    std::uint32_t getTickCount() const { return tickCount; }
+    int getCurrentLevel() const { return currentLevel; }
+    // LevelData::contentHash() of the level being played, or 0 without one (default formation)
+    std::uint64_t getLevelHash() const { return level ? level->contentHash() : 0; }
+    // Events of the most recent update()
+    const TickEvents& getTickEvents() const { return tickEvents; }
+    // Narrow-phase candidate pairs tested during the most recent update()
+    std::size_t getLastPairTests() const { return lastPairTests; }
+    // True once the player has run out of health
+    bool isOver() const { return playerShip.getHealth() <= 0; }
+    // FNV-1a over the live projectiles, enemies and ship health. Two runs that diverge in gameplay
+    // almost surely end with different hashes; the thread count and projectile kernel do not change it.
+    std::uint64_t stateHash() const;
+
+private:
+    // A player shot overlapping an enemy, found by the parallel narrow phase
+    struct ShotHit {
+        std::uint32_t projectile;
+        std::uint32_t enemy;
+    };
+
+    // Collision detection
+    void checkCollisions();
+    // fn(begin, end, thread) over [0, count) in fixed chunks, on the job system when there is one
+    template <typename Fn>
+    void forEachChunk(std::size_t count, std::size_t grain, Fn&& fn);
+
+    // Work split. Chunks are fixed so per-chunk results merge the same way on any thread count.
+    static constexpr std::size_t PROJECTILE_CHUNK = 4096;
+    static constexpr std::size_t ENEMY_CHUNK = 256;
+    static constexpr std::size_t COLLISION_CHUNK = 2048;
+    static constexpr std::size_t CHUNK_SPAWN_RESERVE = ENEMY_CHUNK * 16; // a 16-way volley from every enemy in the chunk
+
+    // Game objects
+    Ship playerShip;
+    ProjectilePool projectiles;
+    std::vector<ProjectileSpawnBatch> enemySpawns; // shots emitted by enemy patterns this tick, one batch per chunk
+    EnemyWorld enemies;
+    BulletVM bullets; // scripted barrages and the bullets they steer
+    std::shared_ptr<const LevelData> level; // kept alive for the spawner
+    WaveSpawner spawner;
+
+    // Broadphase grids rebuilt every tick: enemies, and enemy-owned projectiles
+    static constexpr float COLLISION_CELL_SIZE = 32.0f; // matches the 32x32 sprite frames
+    SpatialHash enemyGrid;
+    SpatialHash enemyShotGrid;
+    std::vector<std::size_t> projectileHits; // dense indices of projectiles to remove this tick
+    std::vector<std::vector<ShotHit>> shotHits; // player shot hits, one list per chunk
+    std::vector<SpatialHash::QueryContext> queryContexts; // one per job thread
+    std::size_t lastPairTests;
+    TickEvents tickEvents;
+
+    Profiler* profiler;
+    JobSystem* jobs;
+
+    // Aim target for ground mode
+    sf::Vector2f aimTarget;
+    bool hasAimTarget;
+
+    // Background scroll
+    float backgroundScrollX; // Offset for scrolling background (wraps between 0 and TILE_WIDTH)
+    float backgroundScrollY; // Offset for scrolling background (wraps between 0 and TILE_HEIGHT)
+    float previousScrollX;   // scroll before the last update (render interpolation)
+    float previousScrollY;
+    static constexpr float SCROLL_SPEED = 240.0f; // Pixels per second for background scroll
+
+    // Timing and game state
+    std::uint32_t seed;
+    std::uint32_t tickCount;
+    float elapsedTime; // seconds since game start
+    int currentLevel;
+};
+
+template <typename Fn>
+void Simulation::forEachChunk(std::size_t count, std::size_t grain, Fn&& fn) {
+    if (jobs) {
+        jobs->parallelFor(count, grain, fn);
+        return;
+    }
+    for (std::size_t begin = 0; begin < count; begin += grain) {
+        fn(begin, std::min(count, begin + grain), std::size_t(0));
+    }
+}
+
+#endif // SIMULATION_H
@@ -0,0 +1,44 @@
+#ifndef SOUND_BANK_H
+#define SOUND_BANK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Decoded sound effects, kept in memory for an SfxMixer to play from.
+// - Files are decoded once through sf::SoundBuffer and stored as mono 16-bit samples (stereo files are downmixed);
+//   the mixer pans them itself
+// - Sounds are referred to by a small id, so triggering one never looks up a name
+// - Fill the bank before a mixer is created from it: the mixer reads samples from its own thread without locking
+class SoundBank {
+public:
+    using SoundId = std::uint16_t;
+    static constexpr SoundId NO_SOUND = 0xFFFF;
+
+    struct Sound {
+        std::vector<std::int16_t> samples; // mono
+        unsigned sampleRate = 0;
+    };
+
+    // Decode a file (anything sf::SoundBuffer reads). NO_SOUND if it cannot be loaded.
+    // A name that is already in the bank keeps its sound and id.
+    SoundId loadFromFile(const std::string& name, const std::string& path);
+    // Add samples that are already mono
+    SoundId add(const std::string& name, std::vector<std::int16_t> samples, unsigned sampleRate);
+    // Square wave sweeping from startHz to endHz over `seconds`, fading out linearly: a stand-in for missing files
+    SoundId addBlip(const std::string& name, float startHz, float endHz, float seconds, unsigned sampleRate = 44100);
+
+    // Id of a name, or NO_SOUND
+    SoundId find(const std::string& name) const;
+    // id must be one this bank returned
+    const Sound& get(SoundId id) const { return sounds[id]; }
+    std::size_t size() const { return sounds.size(); }
+
+private:
+    std::vector<Sound> sounds;
+    std::map<std::string, SoundId> names;
+};
+
+#endif // SOUND_BANK_H
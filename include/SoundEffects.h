@@ -0,0 +1,30 @@
+#ifndef SOUND_EFFECTS_H
+#define SOUND_EFFECTS_H
+
+#include <string>
+#include "SoundBank.h"
+#include "SfxMixer.h"
+#include "Simulation.h"
+
+// The game's sound effects: what they are, where they come from and which gameplay events play them.
+// Shared by the window and the headless runner, so an offline render triggers exactly what a session would.
+namespace SoundEffects {
+    // Sound ids, in the order load() adds them
+    enum Id : SoundBank::SoundId {
+        PlayerShot,
+        EnemyShot,
+        EnemyHit,
+        EnemyDestroyed,
+        PlayerHit,
+        Count
+    };
+
+    // Fill an empty bank with every effect: <directory>/<name>.wav, .ogg or .flac, or a synthesized blip when there
+    // is no such file. Returns how many came from files.
+    int load(SoundBank& bank, const std::string& directory);
+    // Play the sounds for one tick's events. Call the mixer's flush() once per frame, after the frame's ticks,
+    // so repeats within the frame coalesce.
+    void play(const Simulation::TickEvents& events, SfxMixer& mixer);
+}
+
+#endif // SOUND_EFFECTS_H
@@ -0,0 +1,97 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Uniform-grid broadphase over a fixed rectangular area (origin at 0,0).
+// - Rebuilt every tick: clear(), insert() each object, then build()
+// - build() bucket-sorts the inserted entries so every cell is one contiguous run of ids
+// - Objects outside the area are clamped into the border cells, so nothing is ever dropped
+// - query() reports each id at most once, even when an object spans several cells
+// - Queries only read the grid; concurrent queries each need their own QueryContext
+class SpatialHash {
+public:
+    // Per-query scratch: the stamps that report each id once, and a running candidate count
+    struct QueryContext {
+        std::vector<std::uint32_t> stamp;
+        std::uint32_t queryStamp = 0;
+        std::size_t candidates = 0;
+    };
+
+    SpatialHash(float width, float height, float cellSize);
+
+    void clear();
+    // Register object `id` (e.g. a dense index) with its bounds. Only visible to queries after build().
+    void insert(std::uint32_t id, const sf::FloatRect& bounds);
+    void build();
+
+    // Call fn(id) for every object whose cells overlap `bounds`. Candidates still need a narrow-phase test.
+    // fn returns true to stop the query early.
+    template <typename Fn>
+    void query(const sf::FloatRect& bounds, Fn&& fn) const { query(bounds, m_context, fn); }
+    // Same, with caller-owned scratch so several threads can query at once
+    template <typename Fn>
+    void query(const sf::FloatRect& bounds, QueryContext& context, Fn&& fn) const;
+
+    std::size_t objectCount() const { return m_objectCount; }
+    // Candidates handed out by query() without a context since the last clear(), i.e. narrow-phase pair tests
+    std::size_t candidateCount() const { return m_context.candidates; }
+
+private:
+    struct Entry {
+        std::uint32_t cell;
+        std::uint32_t id;
+    };
+
+    int cellX(float x) const;
+    int cellY(float y) const;
+
+    float m_invCellSize;
+    int m_cols;
+    int m_rows;
+
+    std::vector<Entry> m_pending;           // entries inserted since clear()
+    std::vector<std::uint32_t> m_cellStart; // cell -> first index into m_items (size cols*rows+1)
+    std::vector<std::uint32_t> m_items;     // ids grouped by cell
+    std::size_t m_objectCount;
+    std::size_t m_idLimit; // largest inserted id + 1
+
+    // Scratch for queries made without a context
+    mutable QueryContext m_context;
+};
+
+template <typename Fn>
+void SpatialHash::query(const sf::FloatRect& bounds, QueryContext& context, Fn&& fn) const {
+    if (m_items.empty()) return;
+
+    if (context.stamp.size() < m_idLimit) context.stamp.resize(m_idLimit, 0u);
+    if (++context.queryStamp == 0) {
+        // Stamp counter wrapped: forget every previous query
+        std::fill(context.stamp.begin(), context.stamp.end(), 0u);
+        context.queryStamp = 1;
+    }
+
+    int x0 = cellX(bounds.position.x);
+    int x1 = cellX(bounds.position.x + bounds.size.x);
+    int y0 = cellY(bounds.position.y);
+    int y1 = cellY(bounds.position.y + bounds.size.y);
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            std::size_t cell = static_cast<std::size_t>(cy) * m_cols + cx;
+            for (std::uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+                std::uint32_t id = m_items[k];
+                if (context.stamp[id] == context.queryStamp) continue;
+                context.stamp[id] = context.queryStamp;
+                ++context.candidates;
+                if (fn(id)) return;
+            }
+        }
+    }
+}
+
+#endif // SPATIAL_HASH_H
@@ -0,0 +1,52 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+// Collects textured quads and draws them with one draw call per texture.
+// - draw() only appends 6 vertices to the bucket of its texture; nothing reaches the GPU until flush()
+// - flush() submits the buckets in the order their textures were first used, then empties them
+// - Buckets keep their vertex storage between frames, so steady-state batching does not allocate
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    // Queue one sprite. `frame` is the source rect in the texture, `origin` the pivot inside that frame
+    // (same meaning as sf::Sprite::setOrigin), rotation is in degrees and scale may be negative to flip.
+    void draw(const sf::Texture& texture, const sf::IntRect& frame, sf::Vector2f position,
+              sf::Vector2f origin, float rotationDeg = 0.0f, sf::Color tint = sf::Color::White,
+              sf::Vector2f scale = sf::Vector2f(1.0f, 1.0f));
+    // Same, with the rotation given as (cos, sin) so callers that already have it skip the trigonometry
+    void drawRotated(const sf::Texture& texture, const sf::IntRect& frame, sf::Vector2f position,
+                     sf::Vector2f origin, sf::Vector2f rotation, sf::Color tint = sf::Color::White,
+                     sf::Vector2f scale = sf::Vector2f(1.0f, 1.0f));
+
+    // Draw everything queued since the last flush (one layer) and empty the batch
+    void flush(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default);
+    // Empty the batch without drawing (sprites stay counted in the stats)
+    void discard();
+
+    // Frame statistics, accumulated over every flush since resetStats()
+    void resetStats();
+    std::size_t getSpriteCount() const { return m_spriteCount; }
+    std::size_t getDrawCalls() const { return m_drawCalls; }
+    // Draw calls a draw-per-sprite renderer would have issued on top of ours
+    std::size_t getDrawCallsSaved() const { return m_spriteCount - m_drawCalls; }
+
+private:
+    struct Bucket {
+        const sf::Texture* texture;
+        sf::VertexArray vertices;
+    };
+
+    Bucket& bucketFor(const sf::Texture& texture);
+
+    std::vector<Bucket> m_buckets;
+    std::size_t m_activeBuckets; // buckets [0, m_activeBuckets) hold vertices for the current layer
+    std::size_t m_spriteCount;
+    std::size_t m_drawCalls;
+};
+
+#endif // SPRITE_BATCH_H
@@ -0,0 +1,41 @@
+#ifndef WAVE_SPAWNER_H
+#define WAVE_SPAWNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class LevelData;
+class EnemyWorld;
+
+// Streams a level's enemies into the world as the stage clock passes their spawn times.
+// - The level's spawns are already sorted by time, so the queue is just a cursor into them
+// - Tracks and patterns are built the first time a spawn needs them, then shared through the world
+// - Only enemies that have entered the stage take up memory
+class WaveSpawner {
+public:
+    WaveSpawner();
+
+    // Start `level` (which must outlive the spawner's use of it) from stage time 0
+    void start(const LevelData& level);
+    // Advance the stage clock and spawn everything that is now due, in level order
+    void advance(float deltaTime, EnemyWorld& world);
+
+    float getStageTime() const { return stageTime; }
+    // Spawns not reached yet
+    std::size_t getPending() const;
+    bool isFinished() const { return getPending() == 0; }
+
+private:
+    std::int32_t worldTrack(std::int32_t levelTrack, EnemyWorld& world);
+    std::int32_t worldPattern(std::int32_t levelPattern, EnemyWorld& world);
+
+    const LevelData* level;
+    std::size_t next; // first spawn still to come
+    float stageTime;
+    // Level track / pattern index -> index in the world, or -1 until first used
+    std::vector<std::int32_t> tracks;
+    std::vector<std::int32_t> patterns;
+};
+
+#endif // WAVE_SPAWNER_H
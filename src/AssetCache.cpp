@@ -0,0 +1,205 @@
+#include "AssetCache.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+
+SpriteAnimation makeGridAnimation(const sf::Texture* texture, const sf::IntRect& area, sf::Vector2i frameSize) {
+    SpriteAnimation animation;
+    animation.texture = texture;
+    if (frameSize.x <= 0 || frameSize.y <= 0) return animation;
+
+    int cols = std::max(1, area.size.x / frameSize.x);
+    int rows = std::max(1, area.size.y / frameSize.y);
+    // Sheets smaller than one cell are a single frame of their own size
+    sf::Vector2i cell(std::min(frameSize.x, area.size.x), std::min(frameSize.y, area.size.y));
+    animation.frames.reserve(static_cast<std::size_t>(cols * rows));
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            animation.frames.emplace_back(area.position + sf::Vector2i(col * cell.x, row * cell.y), cell);
+        }
+    }
+    return animation;
+}
+
+AssetCache::AssetCache(sf::Vector2i frameSize)
+    : frameSize(frameSize), pageCount(0) {}
+
+bool AssetCache::load(const std::string& directory) {
+    return loadImages(directory) && createTextures();
+}
+
+bool AssetCache::loadImages(const std::string& directory, JobSystem* jobs) {
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    if (!fs::is_directory(directory, ec)) {
+        std::cerr << "Asset directory not found: " << directory << std::endl;
+        return false;
+    }
+
+    // Loading again starts over: nothing from an earlier call is kept or repacked
+    sheets.clear();
+    pages.clear();
+    animations.clear();
+    pageCount = 0;
+
+    // Sorted so the packing (and therefore every frame rect) is the same on every run
+    std::vector<fs::path> files;
+    for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec) && it->path().extension() == ".png") files.push_back(it->path());
+    }
+    std::sort(files.begin(), files.end());
+
+    // Decode into one slot per file (in parallel when there is a pool), then keep the good ones in file order
+    std::vector<Sheet> decoded(files.size());
+    std::vector<std::uint8_t> ok(files.size(), 0);
+    auto decode = [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            ok[i] = decoded[i].image.loadFromFile(files[i]);
+            std::chrono::duration<float, std::milli> took = std::chrono::steady_clock::now() - start;
+            decoded[i].decodeMs = took.count();
+        }
+    };
+    if (jobs) {
+        jobs->parallelFor(files.size(), 1, decode);
+    } else {
+        decode(0, files.size(), 0);
+    }
+
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const fs::path& file = files[i];
+        Sheet& sheet = decoded[i];
+        if (!ok[i]) {
+            std::cerr << "Failed to load sprite sheet: " << file.string() << std::endl;
+            continue;
+        }
+        sf::Vector2u size = sheet.image.getSize();
+        if (size.x + PADDING > ATLAS_SIZE || size.y + PADDING > ATLAS_SIZE) {
+            std::cerr << "Sprite sheet larger than an atlas page, skipped: " << file.string() << std::endl;
+            continue;
+        }
+        fs::path relative = fs::relative(file, directory, ec);
+        sheet.name = (ec ? file.filename() : relative).replace_extension().generic_string();
+        sheets.push_back(std::move(sheet));
+    }
+
+    pack();
+    return !sheets.empty();
+}
+
+void AssetCache::pack() {
+    // Shelf packing: tallest sheets first, left to right, new shelf when a row is full
+    std::vector<std::size_t> order(sheets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return sheets[a].image.getSize().y > sheets[b].image.getSize().y;
+    });
+
+    const int pad = static_cast<int>(PADDING);
+    const int limit = static_cast<int>(ATLAS_SIZE);
+    std::size_t page = 0;
+    int x = pad;
+    int y = pad;
+    int shelfHeight = 0;
+    bool pageUsed = false;
+
+    for (std::size_t index : order) {
+        Sheet& sheet = sheets[index];
+        sf::Vector2i size(static_cast<int>(sheet.image.getSize().x), static_cast<int>(sheet.image.getSize().y));
+
+        if (x + size.x + pad > limit) {
+            x = pad;
+            y += shelfHeight + pad;
+            shelfHeight = 0;
+        }
+        if (y + size.y + pad > limit) {
+            ++page;
+            x = pad;
+            y = pad;
+            shelfHeight = 0;
+        }
+
+        sheet.page = page;
+        sheet.rect = sf::IntRect(sf::Vector2i(x, y), size);
+        x += size.x + pad;
+        shelfHeight = std::max(shelfHeight, size.y);
+        pageUsed = true;
+    }
+    pageCount = pageUsed ? page + 1 : 0;
+
+    animations.clear();
+    for (const Sheet& sheet : sheets) {
+        animations[sheet.name] = makeGridAnimation(nullptr, sheet.rect, frameSize);
+    }
+}
+
+bool AssetCache::createTextures() {
+    if (pageCount == 0) return false;
+
+    // Each page is only as large as what was packed into it
+    std::vector<sf::Vector2u> pageSizes(pageCount, sf::Vector2u(0, 0));
+    for (const Sheet& sheet : sheets) {
+        sf::Vector2u& size = pageSizes[sheet.page];
+        size.x = std::max(size.x, static_cast<unsigned>(sheet.rect.position.x + sheet.rect.size.x) + PADDING);
+        size.y = std::max(size.y, static_cast<unsigned>(sheet.rect.position.y + sheet.rect.size.y) + PADDING);
+    }
+
+    pages.clear();
+    for (std::size_t p = 0; p < pageCount; ++p) {
+        sf::Image pageImage(pageSizes[p], sf::Color::Transparent);
+        for (const Sheet& sheet : sheets) {
+            if (sheet.page != p) continue;
+            sf::Vector2u dest(static_cast<unsigned>(sheet.rect.position.x), static_cast<unsigned>(sheet.rect.position.y));
+            if (!pageImage.copy(sheet.image, dest)) {
+                std::cerr << "Failed to copy " << sheet.name << " into atlas page " << p << std::endl;
+            }
+        }
+
+        auto texture = std::make_unique<sf::Texture>();
+        if (!texture->loadFromImage(pageImage)) {
+            std::cerr << "Failed to create atlas page " << p << std::endl;
+            pages.clear();
+            return false;
+        }
+        pages.push_back(std::move(texture));
+    }
+
+    for (Sheet& sheet : sheets) {
+        animations[sheet.name].texture = pages[sheet.page].get();
+        // The pixels now live on the GPU
+        sheet.image = sf::Image();
+    }
+    return true;
+}
+
+const SpriteAnimation* AssetCache::find(const std::string& name) const {
+    auto it = animations.find(name);
+    return it != animations.end() ? &it->second : nullptr;
+}
+
+const SpriteAnimation& AssetCache::get(const std::string& name) const {
+    static const SpriteAnimation missing;
+    const SpriteAnimation* animation = find(name);
+    return animation ? *animation : missing;
+}
+
+std::vector<std::pair<std::string, float>> AssetCache::getDecodeTimes() const {
+    std::vector<std::pair<std::string, float>> times;
+    times.reserve(sheets.size());
+    for (const Sheet& sheet : sheets) {
+        times.emplace_back(sheet.name, sheet.decodeMs);
+    }
+    return times;
+}
+
+sf::IntRect AssetCache::getSheetRect(const std::string& name) const {
+    for (const Sheet& sheet : sheets) {
+        if (sheet.name == name) return sheet.rect;
+    }
+    return sf::IntRect();
+}
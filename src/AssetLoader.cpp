@@ -0,0 +1,101 @@
+#include "AssetLoader.h"
+#include "AssetCache.h"
+#include "JobSystem.h"
+#include "SoundBank.h"
+#include "SoundEffects.h"
+#include <filesystem>
+#include <iostream>
+
+AssetLoader::AssetLoader(AssetCache& assets, sf::Font& font, sf::Music& music, SoundBank& sounds, JobSystem& jobs)
+    : assets(assets), font(font), music(music), sounds(sounds), jobs(jobs), pending(0), total(0),
+      spritesLoaded(false), fontLoaded(false), soundFiles(0), spritesMs(0.0f), fontMs(0.0f), musicMs(0.0f),
+      soundsMs(0.0f) {}
+
+AssetLoader::~AssetLoader() {
+    for (std::thread& thread : threads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+float AssetLoader::millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+float AssetLoader::getProgress() const {
+    return total > 0 ? 1.0f - static_cast<float>(pending.load(std::memory_order_acquire)) / total : 1.0f;
+}
+
+void AssetLoader::start(const std::string& spriteDirectory, const std::string& fontPath,
+                        const std::vector<std::string>& musicPaths, const std::string& soundDirectory) {
+    startTime = Clock::now();
+    total = 4;
+    pending.store(total, std::memory_order_release);
+
+    // Sprite sheets: this thread hands the files to the job system and helps decode them
+    threads.emplace_back([this, spriteDirectory] {
+        Clock::time_point begin = Clock::now();
+        spritesLoaded = assets.loadImages(spriteDirectory, &jobs);
+        spritesMs = millisecondsSince(begin);
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    });
+
+    threads.emplace_back([this, fontPath] {
+        Clock::time_point begin = Clock::now();
+        fontLoaded = font.openFromFile(fontPath);
+        fontMs = millisecondsSince(begin);
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    });
+
+    // Only try to open paths that exist; each failed open costs a decoder probe
+    threads.emplace_back([this, musicPaths] {
+        Clock::time_point begin = Clock::now();
+        for (const std::string& path : musicPaths) {
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(path, ec) && music.openFromFile(path)) {
+                musicPath = path;
+                break;
+            }
+        }
+        musicMs = millisecondsSince(begin);
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    });
+
+    threads.emplace_back([this, soundDirectory] {
+        Clock::time_point begin = Clock::now();
+        soundFiles = SoundEffects::load(sounds, soundDirectory);
+        soundsMs = millisecondsSince(begin);
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    });
+}
+
+bool AssetLoader::finish() {
+    for (std::thread& thread : threads) {
+        if (thread.joinable()) thread.join();
+    }
+    threads.clear();
+
+    Clock::time_point begin = Clock::now();
+    bool texturesCreated = spritesLoaded && assets.createTextures();
+    float uploadMs = millisecondsSince(begin);
+
+    if (texturesCreated) {
+        std::cout << "Packed " << assets.getSheetCount() << " sprite sheets into "
+                  << assets.getPageCount() << " atlas page(s)" << std::endl;
+    } else {
+        std::cerr << "No sprite sheets loaded; sprites will not be drawn" << std::endl;
+    }
+    if (!fontLoaded) std::cout << "UI font not found; the HUD shows no text" << std::endl;
+    if (musicPath.empty()) std::cout << "Background music not found in expected paths." << std::endl;
+
+    std::cout << "Startup timings (ms):" << std::endl;
+    for (const auto& sheet : assets.getDecodeTimes()) {
+        std::cout << "  decode " << sheet.first << ": " << sheet.second << std::endl;
+    }
+    std::cout << "  sprite sheets (" << jobs.getThreadCount() << " threads): " << spritesMs << std::endl
+              << "  font: " << fontMs << std::endl
+              << "  music" << (musicPath.empty() ? "" : " " + musicPath) << ": " << musicMs << std::endl
+              << "  sound effects (" << soundFiles << " of " << sounds.size() << " from files): " << soundsMs << std::endl
+              << "  atlas upload: " << uploadMs << std::endl
+              << "  total: " << millisecondsSince(startTime) << std::endl;
+    return texturesCreated;
+}
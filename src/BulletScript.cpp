@@ -0,0 +1,219 @@
+#include "BulletScript.h"
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+
+namespace {
+
+const float DEGREES_TO_RADIANS = 3.14159265f / 180.0f;
+
+bool parseFloat(const std::string& text, float& out) {
+    char* end = nullptr;
+    out = std::strtof(text.c_str(), &end);
+    return !text.empty() && end && *end == '\0';
+}
+
+bool parseInt(const std::string& text, long& out) {
+    char* end = nullptr;
+    out = std::strtol(text.c_str(), &end, 10);
+    return !text.empty() && end && *end == '\0';
+}
+
+bool parseMode(const std::string& text, bool allowAim, std::uint8_t& out) {
+    static const char* const names[BulletCode::ModeCount] = { "aim", "absolute", "relative", "sequence" };
+    for (std::uint8_t m = allowAim ? 0 : 1; m < BulletCode::ModeCount; ++m) {
+        if (text == names[m]) {
+            out = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool compileBulletScript(const std::string& source, BulletProgram& program, std::string& error) {
+    using namespace BulletCode;
+
+    // Built on the side and appended only once the whole script compiled
+    std::vector<Instruction> instructions;
+    std::vector<Action> actions;
+    std::map<std::string, std::uint32_t> actionNames; // local action index by name
+    std::vector<std::pair<std::size_t, std::string>> fireTargets; // instruction -> action name, resolved at the end
+    std::vector<std::size_t> repeats; // open repeats, innermost last
+    bool inAction = false;
+    std::string actionName;
+
+    std::istringstream lines(source);
+    std::string line;
+    int lineNumber = 0;
+    auto fail = [&](const std::string& what) {
+        error = "line " + std::to_string(lineNumber) + ": " + what;
+        return false;
+    };
+
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::vector<std::string> w;
+        for (std::string word; words >> word;) w.push_back(word);
+        if (w.empty()) continue;
+
+        if (w[0] == "action") {
+            if (w.size() != 2) return fail("expected: action <name>");
+            if (inAction) return fail("action '" + w[1] + "' inside action '" + actionName + "'");
+            if (actionNames.count(w[1])) return fail("action '" + w[1] + "' defined twice");
+            actionNames[w[1]] = static_cast<std::uint32_t>(actions.size());
+            actions.push_back(Action{static_cast<std::uint32_t>(instructions.size()), 0});
+            inAction = true;
+            actionName = w[1];
+            continue;
+        }
+        if (!inAction) return fail("'" + w[0] + "' outside an action");
+
+        Instruction in{0, 0, 0, 0.0f, 0.0f};
+        if (w[0] == "end") {
+            if (w.size() != 1) return fail("expected: end");
+            if (repeats.empty()) {
+                Action& action = actions.back();
+                action.count = static_cast<std::uint32_t>(instructions.size()) - action.first;
+                inAction = false;
+                continue;
+            }
+            in.op = Loop;
+            in.arg = static_cast<std::uint16_t>(instructions.size() - repeats.back());
+            repeats.pop_back();
+        } else if (w[0] == "fire") {
+            std::uint8_t directionMode, speedMode;
+            if (w.size() != 5 && w.size() != 6) return fail("expected: fire <dir-mode> <degrees> <speed-mode> <speed> [<action>]");
+            if (!parseMode(w[1], true, directionMode)) return fail("unknown direction mode '" + w[1] + "'");
+            if (!parseMode(w[3], false, speedMode)) return fail("unknown speed mode '" + w[3] + "'");
+            if (!parseFloat(w[2], in.a) || !parseFloat(w[4], in.b)) return fail("bad angle or speed");
+            in.op = Fire;
+            in.mode = static_cast<std::uint8_t>(directionMode | (speedMode << 4));
+            in.a *= DEGREES_TO_RADIANS;
+            in.arg = NO_ACTION;
+            if (w.size() == 6) fireTargets.emplace_back(instructions.size(), w[5]);
+        } else if (w[0] == "wait") {
+            if (w.size() != 2 || !parseFloat(w[1], in.a) || in.a < 0.0f) return fail("expected: wait <seconds>");
+            in.op = Wait;
+        } else if (w[0] == "repeat") {
+            long count = 0;
+            if (w.size() != 2 || !parseInt(w[1], count) || count < 1 || count > 0xFFFF) {
+                return fail("expected: repeat <count>, count 1 to 65535");
+            }
+            if (repeats.size() == MAX_LOOP_DEPTH) return fail("repeats nested deeper than " + std::to_string(MAX_LOOP_DEPTH));
+            in.op = Repeat;
+            in.arg = static_cast<std::uint16_t>(count);
+            repeats.push_back(instructions.size());
+        } else if (w[0] == "turn" || w[0] == "speed") {
+            bool turn = w[0] == "turn";
+            if (w.size() != 4 || !parseMode(w[1], turn, in.mode) || !parseFloat(w[2], in.a) || !parseFloat(w[3], in.b)
+                || in.b < 0.0f) {
+                return fail(turn ? "expected: turn <dir-mode> <degrees> <seconds>" : "expected: speed <speed-mode> <value> <seconds>");
+            }
+            in.op = turn ? Turn : Accelerate;
+            if (turn) in.a *= DEGREES_TO_RADIANS;
+        } else if (w[0] == "vanish") {
+            if (w.size() != 1) return fail("expected: vanish");
+            in.op = Vanish;
+        } else {
+            return fail("unknown statement '" + w[0] + "'");
+        }
+        if (instructions.size() - actions.back().first >= 0xFFFF) return fail("action '" + actionName + "' is too long");
+        instructions.push_back(in);
+    }
+    if (inAction) return fail("action '" + actionName + "' has no end");
+
+    auto top = actionNames.find("top");
+    if (top == actionNames.end()) {
+        error = "no action named 'top'";
+        return false;
+    }
+    std::size_t actionBase = program.actions.size();
+    for (const auto& target : fireTargets) {
+        auto found = actionNames.find(target.second);
+        if (found == actionNames.end()) {
+            error = "fire uses unknown action '" + target.second + "'";
+            return false;
+        }
+        std::size_t global = actionBase + found->second;
+        if (global >= NO_ACTION) {
+            error = "too many actions";
+            return false;
+        }
+        instructions[target.first].arg = static_cast<std::uint16_t>(global);
+    }
+
+    std::uint32_t instructionBase = static_cast<std::uint32_t>(program.instructions.size());
+    for (Action& action : actions) action.first += instructionBase;
+    program.instructions.insert(program.instructions.end(), instructions.begin(), instructions.end());
+    program.actions.insert(program.actions.end(), actions.begin(), actions.end());
+    program.scripts.push_back(static_cast<std::uint32_t>(actionBase + top->second));
+    return true;
+}
+
+bool loadBulletScript(const std::string& path, BulletProgram& program, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!compileBulletScript(source, program, error)) {
+        error = path + ", " + error;
+        return false;
+    }
+    return true;
+}
+
+bool validateBulletProgram(const BulletCode::Instruction* instructions, std::size_t instructionCount,
+                           const BulletCode::Action* actions, std::size_t actionCount,
+                           const std::uint32_t* scripts, std::size_t scriptCount, std::string& error) {
+    using namespace BulletCode;
+
+    for (std::size_t s = 0; s < scriptCount; ++s) {
+        if (scripts[s] >= actionCount) {
+            error = "script " + std::to_string(s) + " starts at a missing action";
+            return false;
+        }
+    }
+    for (std::size_t a = 0; a < actionCount; ++a) {
+        const Action& action = actions[a];
+        if (action.first > instructionCount || action.count > instructionCount - action.first) {
+            error = "action " + std::to_string(a) + " runs outside the instructions";
+            return false;
+        }
+        // Every Loop must close the innermost open Repeat, and every Repeat must be closed
+        std::uint32_t open[MAX_LOOP_DEPTH];
+        std::size_t depth = 0;
+        for (std::uint32_t k = 0; k < action.count; ++k) {
+            const Instruction& in = instructions[action.first + k];
+            bool ok = in.op < OpCount;
+            if (in.op == Fire) {
+                ok = (in.mode & 0x0F) < ModeCount && (in.mode >> 4) < ModeCount && (in.mode >> 4) != Aim
+                     && (in.arg == NO_ACTION || in.arg < actionCount);
+            } else if (in.op == Turn || in.op == Accelerate) {
+                ok = in.mode < ModeCount && (in.op == Turn || in.mode != Aim);
+            } else if (in.op == Repeat) {
+                ok = depth < MAX_LOOP_DEPTH && in.arg > 0;
+                if (ok) open[depth++] = k;
+            } else if (in.op == Loop) {
+                ok = depth > 0 && in.arg == k - open[depth - 1];
+                if (ok) --depth;
+            }
+            if (!ok) {
+                error = "action " + std::to_string(a) + ", instruction " + std::to_string(k) + " is malformed";
+                return false;
+            }
+        }
+        if (depth != 0) {
+            error = "action " + std::to_string(a) + " has an unclosed repeat";
+            return false;
+        }
+    }
+    return true;
+}
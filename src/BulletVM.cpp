@@ -0,0 +1,205 @@
+#include "BulletVM.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Angle in [-pi, pi), so headings never drift out of the range the sine table is accurate in
+float wrapAngle(float radians) {
+    return radians - FastMath::TWO_PI * std::floor(radians / FastMath::TWO_PI + 0.5f);
+}
+
+float aimAngle(const sf::Vector2f& from, const sf::Vector2f& to) {
+    return std::atan2(to.y - from.y, to.x - from.x);
+}
+
+} // namespace
+
+BulletVM::BulletVM(std::size_t capacity)
+    : m_capacity(capacity), m_size(0), m_runners(capacity),
+      m_instructions(nullptr), m_actions(nullptr), m_scripts(nullptr), m_scriptCount(0) {}
+
+void BulletVM::setProgram(const BulletCode::Instruction* instructions, std::size_t /*instructionCount*/,
+                          const BulletCode::Action* actions, std::size_t /*actionCount*/,
+                          const std::uint32_t* scripts, std::size_t scriptCount) {
+    m_instructions = instructions;
+    m_actions = actions;
+    m_scripts = scripts;
+    m_scriptCount = scriptCount;
+    clear();
+}
+
+void BulletVM::setProgram(const BulletProgram& program) {
+    setProgram(program.instructions.data(), program.instructions.size(), program.actions.data(), program.actions.size(),
+               program.scripts.data(), program.scripts.size());
+}
+
+BulletVM::Runner BulletVM::makeRunner(std::uint32_t action, float direction, float speed) const {
+    Runner runner{};
+    runner.pc = m_actions[action].first;
+    runner.end = runner.pc + m_actions[action].count;
+    runner.direction = direction;
+    runner.speed = speed;
+    runner.lastDirection = direction;
+    runner.lastSpeed = speed;
+    return runner;
+}
+
+bool BulletVM::launch(std::int32_t script, float x, float y, const sf::Vector2f& target) {
+    if (script < 0 || static_cast<std::size_t>(script) >= m_scriptCount || m_size == m_capacity) return false;
+    Runner runner = makeRunner(m_scripts[script], aimAngle(sf::Vector2f(x, y), target), 0.0f);
+    runner.x = x;
+    runner.y = y;
+    m_runners[m_size++] = runner;
+    return true;
+}
+
+void BulletVM::launch(const ProjectileSpawnBatch& batch, const sf::Vector2f& target) {
+    for (const ProjectileSpawnBatch::Launch& l : batch.getLaunches()) {
+        launch(l.script, l.x, l.y, target);
+    }
+}
+
+void BulletVM::update(float deltaTime, ProjectilePool& projectiles, const sf::Vector2f& target) {
+    // Finished runners are dropped by compacting in place, which keeps the survivors in order
+    std::size_t count = m_size;
+    std::size_t kept = 0;
+    for (std::size_t r = 0; r < count; ++r) {
+        if (!step(m_runners[r], deltaTime, projectiles, target)) continue;
+        if (kept != r) m_runners[kept] = m_runners[r];
+        ++kept;
+    }
+    // Runners started by this pass
+    for (std::size_t r = count; r < m_size; ++r) {
+        m_runners[kept++] = m_runners[r];
+    }
+    m_size = kept;
+}
+
+bool BulletVM::step(Runner& runner, float deltaTime, ProjectilePool& projectiles, const sf::Vector2f& target) {
+    using namespace BulletCode;
+
+    // A bullet's runner ends with its projectile (hit, culled or expired)
+    std::size_t index = 0;
+    sf::Vector2f position(runner.x, runner.y);
+    bool isBullet = runner.bullet.isValid();
+    if (isBullet) {
+        index = projectiles.indexOf(runner.bullet);
+        if (index == projectiles.size()) return false;
+        position = projectiles.getPosition(index);
+    }
+
+    bool steered = false;
+    runner.wait -= deltaTime;
+    for (int steps = 0; runner.pc < runner.end && runner.wait <= 0.0f && steps < MAX_STEPS_PER_TICK; ++steps) {
+        const Instruction& in = m_instructions[runner.pc++];
+        switch (in.op) {
+        case Fire:
+            fire(runner, in, position, projectiles, target);
+            break;
+        case Wait:
+            runner.wait += in.a;
+            break;
+        case Repeat:
+            runner.loopLeft[runner.loopDepth++] = in.arg;
+            break;
+        case Loop:
+            if (--runner.loopLeft[runner.loopDepth - 1] > 0) {
+                runner.pc -= in.arg;
+            } else {
+                --runner.loopDepth;
+            }
+            break;
+        case Turn: {
+            float delta = in.a;
+            if (in.mode == Aim) delta = wrapAngle(aimAngle(position, target) + in.a - runner.direction);
+            else if (in.mode == Absolute) delta = wrapAngle(in.a - runner.direction);
+            if (in.mode == Sequence) {
+                runner.turnRate = in.a;
+                runner.turnTime = in.b;
+            } else if (in.b > 0.0f) {
+                runner.turnRate = delta / in.b;
+                runner.turnTime = in.b;
+            } else {
+                runner.direction = wrapAngle(runner.direction + delta);
+                runner.turnTime = 0.0f;
+                steered = true;
+            }
+            break;
+        }
+        case Accelerate: {
+            float delta = in.mode == Absolute ? in.a - runner.speed : in.a;
+            if (in.mode == Sequence) {
+                runner.acceleration = in.a;
+                runner.accelerationTime = in.b;
+            } else if (in.b > 0.0f) {
+                runner.acceleration = delta / in.b;
+                runner.accelerationTime = in.b;
+            } else {
+                runner.speed += delta;
+                runner.accelerationTime = 0.0f;
+                steered = true;
+            }
+            break;
+        }
+        case Vanish:
+            if (isBullet) projectiles.remove(index);
+            return false;
+        default:
+            break;
+        }
+    }
+    // An action that ran out stays out: do not carry the overshoot of its last wait
+    if (runner.pc >= runner.end) runner.wait = 0.0f;
+
+    if (runner.turnTime > 0.0f) {
+        float t = std::min(deltaTime, runner.turnTime);
+        runner.direction = wrapAngle(runner.direction + runner.turnRate * t);
+        runner.turnTime -= t;
+        steered = true;
+    }
+    if (runner.accelerationTime > 0.0f) {
+        float t = std::min(deltaTime, runner.accelerationTime);
+        runner.speed += runner.acceleration * t;
+        runner.accelerationTime -= t;
+        steered = true;
+    }
+    if (steered && isBullet) {
+        float s, c;
+        FastMath::sinCos(runner.direction, s, c);
+        projectiles.steer(index, c, s, runner.speed);
+    }
+    return runner.pc < runner.end || runner.turnTime > 0.0f || runner.accelerationTime > 0.0f;
+}
+
+void BulletVM::fire(Runner& runner, const BulletCode::Instruction& in, const sf::Vector2f& position,
+                    ProjectilePool& projectiles, const sf::Vector2f& target) {
+    using namespace BulletCode;
+
+    float direction = in.a;
+    switch (in.mode & 0x0F) {
+    case Aim: direction += aimAngle(position, target); break;
+    case Relative: direction += runner.direction; break;
+    case Sequence: direction += runner.lastDirection; break;
+    default: break;
+    }
+    direction = wrapAngle(direction);
+    float speed = in.b;
+    switch (in.mode >> 4) {
+    case Relative: speed += runner.speed; break;
+    case Sequence: speed += runner.lastSpeed; break;
+    default: break;
+    }
+    runner.lastDirection = direction;
+    runner.lastSpeed = speed;
+
+    float s, c;
+    FastMath::sinCos(direction, s, c);
+    ProjectileHandle bullet = projectiles.spawnDirected(position.x, position.y, c, s, speed, Projectile::Owner::Enemy);
+    // With the VM full the bullet still flies, just unscripted
+    if (!bullet.isValid() || in.arg == NO_ACTION || m_size == m_capacity) return;
+    Runner child = makeRunner(in.arg, direction, speed);
+    child.bullet = bullet;
+    m_runners[m_size++] = child;
+}
@@ -0,0 +1,330 @@
+#include "EnemyWorld.h"
+#include "Enemy.h"
+#include "ShootingPattern.h"
+#include "PathTrack.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// xorshift32: cheap, and good enough to pick a wander heading
+std::uint32_t nextRandom(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// PatternKind values other than None
+const std::size_t PATTERN_TYPES = 4;
+}
+
+EnemyWorld::EnemyWorld(std::size_t capacity)
+    : m_capacity(capacity), m_size(0),
+      m_transform(capacity), m_motion(capacity), m_health(capacity), m_path(capacity),
+      m_animation(capacity), m_shooter(capacity), m_slotOf(capacity),
+      m_indexOf(capacity), m_generation(capacity, 0), m_freeSlots(capacity), m_spawnRng(1u) {
+    setSeed(DEFAULT_SEED);
+    clear();
+}
+
+void EnemyWorld::clear() {
+    m_size = 0;
+    // Hand out low slots first so ids stay small and predictable
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+        m_freeSlots[i] = static_cast<std::uint32_t>(m_capacity - 1 - i);
+        ++m_generation[i];
+    }
+}
+
+void EnemyWorld::setSeed(std::uint32_t seed) {
+    // Spread small seeds over the whole state; never zero, or xorshift would stay at zero
+    m_spawnRng = seed * 2654435761u | 1u;
+}
+
+std::int32_t EnemyWorld::addTrack(std::shared_ptr<const PathTrack> track) {
+    if (!track) return NO_TRACK;
+    m_tracks.push_back(std::move(track));
+    return static_cast<std::int32_t>(m_tracks.size() - 1);
+}
+
+std::int32_t EnemyWorld::addPattern(ShootingPattern pattern) {
+    PatternRef ref;
+    if (DirectAtPlayerPattern* direct = std::get_if<DirectAtPlayerPattern>(&pattern)) {
+        ref = PatternRef{PatternKind::DirectAtPlayer, static_cast<std::int32_t>(m_directPatterns.size()), direct->getInterval()};
+        m_directPatterns.push_back(std::move(*direct));
+    } else if (RadialPattern* radial = std::get_if<RadialPattern>(&pattern)) {
+        ref = PatternRef{PatternKind::Radial, static_cast<std::int32_t>(m_radialPatterns.size()), radial->getInterval()};
+        m_radialPatterns.push_back(std::move(*radial));
+    } else if (SpreadPattern* spread = std::get_if<SpreadPattern>(&pattern)) {
+        ref = PatternRef{PatternKind::Spread, static_cast<std::int32_t>(m_spreadPatterns.size()), spread->getInterval()};
+        m_spreadPatterns.push_back(std::move(*spread));
+    } else {
+        ScriptedPattern& scripted = std::get<ScriptedPattern>(pattern);
+        ref = PatternRef{PatternKind::Scripted, static_cast<std::int32_t>(m_scriptedPatterns.size()), scripted.getInterval()};
+        m_scriptedPatterns.push_back(scripted);
+    }
+    m_patterns.push_back(ref);
+    return static_cast<std::int32_t>(m_patterns.size() - 1);
+}
+
+EnemyId EnemyWorld::spawn(float x, float y, float speed, int health) {
+    if (m_size == m_capacity) return EnemyId();
+
+    std::size_t i = m_size++;
+    // Pop a free slot (the stack holds capacity - i entries before this one is taken)
+    std::uint32_t slot = m_freeSlots[m_capacity - i - 1];
+
+    // Start in a random direction
+    float angle = (nextRandom(m_spawnRng) % 360) * 3.14159f / 180.0f;
+    float interval = 1.0f + (nextRandom(m_spawnRng) % 200) / 100.0f;
+    // Never zero, or xorshift would stay at zero
+    std::uint32_t seed = nextRandom(m_spawnRng) * 2654435761u | 1u;
+
+    m_transform[i] = EnemyTransform{sf::Vector2f(x, y), sf::Vector2f(x, y)};
+    m_motion[i] = EnemyMotion{FastMath::direction(angle) * speed, speed, 0.0f, interval, seed};
+    m_health[i] = EnemyHealth{health, health};
+    m_path[i] = EnemyPathCursor{NO_TRACK, 0.0f, 0.0f, sf::Vector2f(0.f, 0.f), true};
+    m_animation[i] = EnemyAnimation{0.0f, 0};
+    m_shooter[i] = EnemyShooter{PatternKind::None, NO_PATTERN, 0.0f, 0.0f};
+
+    m_slotOf[i] = slot;
+    m_indexOf[slot] = static_cast<std::uint32_t>(i);
+
+    EnemyId id;
+    id.slot = slot;
+    id.generation = m_generation[slot];
+    return id;
+}
+
+void EnemyWorld::setTrack(EnemyId id, std::int32_t track, float speed, float startDistance, sf::Vector2f offset) {
+    std::size_t i = indexOf(id);
+    if (i == m_size) return;
+
+    EnemyPathCursor& cursor = m_path[i];
+    if (track < 0 || static_cast<std::size_t>(track) >= m_tracks.size()) {
+        cursor = EnemyPathCursor{NO_TRACK, 0.0f, 0.0f, sf::Vector2f(0.f, 0.f), true};
+        return;
+    }
+    const PathTrack& path = *m_tracks[track];
+    cursor = EnemyPathCursor{track, path.wrap(startDistance), speed, offset, false};
+    m_transform[i].position = path.positionAt(cursor.distance) + offset;
+    m_transform[i].previous = m_transform[i].position;
+    // The track drives the position from now on
+    m_motion[i].velocity = sf::Vector2f(0.f, 0.f);
+}
+
+void EnemyWorld::setPattern(EnemyId id, std::int32_t pattern) {
+    std::size_t i = indexOf(id);
+    if (i == m_size) return;
+
+    EnemyShooter& shooter = m_shooter[i];
+    if (pattern < 0 || static_cast<std::size_t>(pattern) >= m_patterns.size()) {
+        shooter = EnemyShooter{PatternKind::None, NO_PATTERN, 0.0f, 0.0f};
+        return;
+    }
+    const PatternRef& ref = m_patterns[pattern];
+    shooter = EnemyShooter{ref.kind, ref.index, 0.0f, ref.interval};
+}
+
+void EnemyWorld::remove(std::size_t index) {
+    if (index >= m_size) return;
+
+    std::uint32_t slot = m_slotOf[index];
+    ++m_generation[slot];
+
+    std::size_t last = --m_size;
+    if (index != last) {
+        m_transform[index] = m_transform[last];
+        m_motion[index] = m_motion[last];
+        m_health[index] = m_health[last];
+        m_path[index] = m_path[last];
+        m_animation[index] = m_animation[last];
+        m_shooter[index] = m_shooter[last];
+        m_slotOf[index] = m_slotOf[last];
+        m_indexOf[m_slotOf[index]] = static_cast<std::uint32_t>(index);
+    }
+
+    // Push the slot back on the free stack
+    m_freeSlots[m_capacity - m_size - 1] = slot;
+}
+
+bool EnemyWorld::remove(EnemyId id) {
+    std::size_t index = indexOf(id);
+    if (index == m_size) return false;
+    remove(index);
+    return true;
+}
+
+void EnemyWorld::removeDead() {
+    for (std::size_t i = 0; i < m_size;) {
+        if (m_health[i].current <= 0) {
+            remove(i); // the last enemy moved into i; test it next
+        } else {
+            ++i;
+        }
+    }
+}
+
+void EnemyWorld::removeDeparted(int screenWidth, int screenHeight) {
+    // Off screen means the whole sprite is outside
+    const float margin = Enemy::FRAME_SIZE;
+    for (std::size_t i = 0; i < m_size;) {
+        const EnemyPathCursor& path = m_path[i];
+        const sf::Vector2f& p = m_transform[i].position;
+        bool offScreen = p.x < -margin || p.y < -margin || p.x > screenWidth + margin || p.y > screenHeight + margin;
+        if (path.track != NO_TRACK && path.finished && offScreen) {
+            remove(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool EnemyWorld::isAlive(EnemyId id) const {
+    return id.slot < m_capacity && m_generation[id.slot] == id.generation
+        && m_indexOf[id.slot] < m_size && m_slotOf[m_indexOf[id.slot]] == id.slot;
+}
+
+std::size_t EnemyWorld::indexOf(EnemyId id) const {
+    return isAlive(id) ? m_indexOf[id.slot] : m_size;
+}
+
+EnemyId EnemyWorld::idAt(std::size_t index) const {
+    EnemyId id;
+    if (index < m_size) {
+        id.slot = m_slotOf[index];
+        id.generation = m_generation[id.slot];
+    }
+    return id;
+}
+
+sf::FloatRect EnemyWorld::getBounds(std::size_t index) const {
+    // Frame-sized box centered on the enemy
+    const sf::Vector2f& p = m_transform[index].position;
+    float half = Enemy::FRAME_SIZE / 2.f;
+    return sf::FloatRect({p.x - half, p.y - half}, {Enemy::FRAME_SIZE, Enemy::FRAME_SIZE});
+}
+
+sf::FloatRect EnemyWorld::getSweptBounds(std::size_t index) const {
+    const EnemyTransform& t = m_transform[index];
+    float half = Enemy::FRAME_SIZE / 2.f;
+    sf::Vector2f min(std::min(t.position.x, t.previous.x) - half, std::min(t.position.y, t.previous.y) - half);
+    sf::Vector2f max(std::max(t.position.x, t.previous.x) + half, std::max(t.position.y, t.previous.y) + half);
+    return sf::FloatRect(min, max - min);
+}
+
+void EnemyWorld::takeDamage(std::size_t index, int damage) {
+    m_health[index].current = std::max(0, m_health[index].current - damage);
+}
+
+bool EnemyWorld::hasPath(std::size_t index) const {
+    return m_path[index].track != NO_TRACK && !m_path[index].finished;
+}
+
+void EnemyWorld::update(float deltaTime, int screenWidth, int screenHeight, const sf::Vector2f& playerPos,
+                        ProjectileSpawnBatch& spawns, std::size_t begin, std::size_t end) {
+    end = std::min(end, m_size);
+    for (std::size_t i = begin; i < end; ++i) {
+        m_transform[i].previous = m_transform[i].position;
+    }
+    updatePaths(deltaTime, begin, end);
+    updateWander(deltaTime, screenWidth, screenHeight, begin, end);
+    updateAnimation(deltaTime, begin, end);
+    updateShooters(deltaTime, playerPos, spawns, begin, end);
+}
+
+void EnemyWorld::updatePaths(float deltaTime, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        EnemyPathCursor& cursor = m_path[i];
+        if (cursor.track == NO_TRACK || cursor.finished) continue;
+
+        // Constant speed along the track; movement left over at a waypoint carries past it
+        const PathTrack& track = *m_tracks[cursor.track];
+        float distance = cursor.distance + cursor.speed * deltaTime;
+        if (track.isLooping()) {
+            distance = track.wrap(distance);
+        } else if (distance >= track.getLength()) {
+            distance = track.getLength();
+            cursor.finished = true;
+        }
+        cursor.distance = distance;
+        m_transform[i].position = track.positionAt(distance) + cursor.offset;
+    }
+}
+
+void EnemyWorld::updateWander(float deltaTime, int screenWidth, int screenHeight, std::size_t begin, std::size_t end) {
+    // Drift towards the right side of the screen, picking a new heading every interval
+    float centerX = screenWidth * 0.7f;
+    float centerY = screenHeight / 2.0f;
+
+    for (std::size_t i = begin; i < end; ++i) {
+        // Enemies on a track stay where it put them, even once it has finished
+        if (m_path[i].track != NO_TRACK) continue;
+
+        EnemyMotion& motion = m_motion[i];
+        sf::Vector2f& position = m_transform[i].position;
+
+        motion.wanderTimer += deltaTime;
+        if (motion.wanderTimer >= motion.wanderInterval) {
+            motion.wanderTimer = 0.0f;
+
+            // Head for the centre, turned by up to 45 degrees either way
+            sf::Vector2f toCenter = FastMath::normalize(sf::Vector2f(centerX - position.x, centerY - position.y));
+            if (toCenter.x == 0.0f && toCenter.y == 0.0f) toCenter.x = 1.0f; // already there: head right
+            float variation = (static_cast<int>(nextRandom(motion.rng) % 90) - 45) * 3.14159f / 180.0f;
+            float s, c;
+            FastMath::sinCos(variation, s, c);
+
+            motion.velocity.x = (toCenter.x * c - toCenter.y * s) * motion.speed;
+            motion.velocity.y = (toCenter.x * s + toCenter.y * c) * motion.speed;
+        }
+
+        position += motion.velocity * deltaTime;
+    }
+}
+
+void EnemyWorld::updateAnimation(float deltaTime, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        EnemyAnimation& animation = m_animation[i];
+        animation.timer += deltaTime;
+        if (animation.timer >= Enemy::FRAME_DURATION) {
+            animation.timer = 0.0f;
+            animation.frame = static_cast<std::uint8_t>((animation.frame + 1) % Enemy::TOTAL_FRAMES);
+        }
+    }
+}
+
+void EnemyWorld::updateShooters(float deltaTime, const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns,
+                                std::size_t begin, std::size_t end) {
+    // Reload pass over the block, sorting the reloaded shooters by pattern type; then one fire loop per type
+    std::uint32_t ready[PATTERN_TYPES][SHOOTER_BLOCK];
+    for (std::size_t block = begin; block < end; block += SHOOTER_BLOCK) {
+        std::size_t blockEnd = std::min(end, block + SHOOTER_BLOCK);
+        std::size_t readyCount[PATTERN_TYPES] = { 0, 0, 0, 0 };
+        for (std::size_t i = block; i < blockEnd; ++i) {
+            EnemyShooter& shooter = m_shooter[i];
+            if (shooter.kind == PatternKind::None) continue;
+            shooter.timer += deltaTime;
+            if (shooter.timer < shooter.interval) continue;
+            std::size_t kind = static_cast<std::size_t>(shooter.kind) - 1;
+            ready[kind][readyCount[kind]++] = static_cast<std::uint32_t>(i);
+        }
+        fireReady(m_directPatterns, ready[0], readyCount[0], playerPos, spawns);
+        fireReady(m_radialPatterns, ready[1], readyCount[1], playerPos, spawns);
+        fireReady(m_spreadPatterns, ready[2], readyCount[2], playerPos, spawns);
+        fireReady(m_scriptedPatterns, ready[3], readyCount[3], playerPos, spawns);
+    }
+}
+
+template <typename Pattern>
+void EnemyWorld::fireReady(const std::vector<Pattern>& patterns, const std::uint32_t* ready, std::size_t count,
+                           const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns) {
+    for (std::size_t r = 0; r < count; ++r) {
+        std::uint32_t i = ready[r];
+        EnemyShooter& shooter = m_shooter[i];
+        if (patterns[shooter.pattern].fire(m_transform[i].position, playerPos, spawns)) {
+            shooter.timer = 0.0f;
+        }
+    }
+}
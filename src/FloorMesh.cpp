@@ -0,0 +1,112 @@
+#include "FloorMesh.h"
+#include "IsometricUtils.h"
+#include <cmath>
+
+FloorMesh::FloorMesh(int gridSize)
+    : m_gridSize(gridSize), m_built(false), m_useBuffer(false),
+      m_buffer(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static) {}
+
+void FloorMesh::appendTriangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color) {
+    sf::Vertex v;
+    v.color = color;
+    v.position = a; m_vertices.push_back(v);
+    v.position = b; m_vertices.push_back(v);
+    v.position = c; m_vertices.push_back(v);
+}
+
+void FloorMesh::appendLine(sf::Vector2f a, sf::Vector2f b, float thickness, sf::Color color) {
+    // A line is a thin quad centered on the segment
+    sf::Vector2f d = b - a;
+    float len = std::sqrt(d.x * d.x + d.y * d.y);
+    if (len <= 0.0f) return;
+    sf::Vector2f n(-d.y / len * thickness / 2.0f, d.x / len * thickness / 2.0f);
+    appendTriangle(a - n, b - n, b + n, color);
+    appendTriangle(a - n, b + n, a + n, color);
+}
+
+void FloorMesh::appendTile(int x, int y, sf::Color fill, sf::Color outline, float outlineThickness) {
+    // Use tile-unit coordinates (x,y) rather than multiplying by TILE_WIDTH/TILE_HEIGHT
+    float worldX = static_cast<float>(x);
+    float worldY = static_cast<float>(y);
+
+    // Diamond corners: top, right, bottom, left (half a tile away from the center)
+    sf::Vector2f p[4] = {
+        IsometricUtils::worldToScreen(worldX, worldY - 0.5f),
+        IsometricUtils::worldToScreen(worldX + 0.5f, worldY),
+        IsometricUtils::worldToScreen(worldX, worldY + 0.5f),
+        IsometricUtils::worldToScreen(worldX - 0.5f, worldY)
+    };
+
+    appendTriangle(p[0], p[1], p[2], fill);
+    appendTriangle(p[0], p[2], p[3], fill);
+
+    // Outline grows outward like sf::Shape's: each corner moves along the mitered edge normals
+    sf::Vector2f outer[4];
+    for (int i = 0; i < 4; ++i) {
+        sf::Vector2f prev = p[(i + 3) % 4];
+        sf::Vector2f next = p[(i + 1) % 4];
+        auto edgeNormal = [](sf::Vector2f a, sf::Vector2f b) {
+            sf::Vector2f n(a.y - b.y, b.x - a.x);
+            float len = std::sqrt(n.x * n.x + n.y * n.y);
+            return n / len;
+        };
+        // Corners are clockwise on screen, so flip the normals to point away from the center
+        sf::Vector2f n1 = -edgeNormal(prev, p[i]);
+        sf::Vector2f n2 = -edgeNormal(p[i], next);
+        float factor = 1.0f + (n1.x * n2.x + n1.y * n2.y);
+        outer[i] = p[i] + (n1 + n2) / factor * outlineThickness;
+    }
+    for (int i = 0; i < 4; ++i) {
+        int j = (i + 1) % 4;
+        appendTriangle(p[i], p[j], outer[j], outline);
+        appendTriangle(p[i], outer[j], outer[i], outline);
+    }
+}
+
+void FloorMesh::build() {
+    m_vertices.clear();
+
+    int gridWidth = m_gridSize;
+    int gridHeight = m_gridSize;
+    sf::Color gridColor(60, 60, 80, 180); // Semi-transparent grid
+
+    // Grid lines of constant worldX (varying worldY) then constant worldY (varying worldX), in tile units
+    for (int i = -gridWidth; i <= gridWidth; ++i) {
+        float worldX = static_cast<float>(i);
+        appendLine(IsometricUtils::worldToScreen(worldX, static_cast<float>(-gridHeight)),
+                   IsometricUtils::worldToScreen(worldX, static_cast<float>(gridHeight)), 1.0f, gridColor);
+    }
+    for (int i = -gridHeight; i <= gridHeight; ++i) {
+        float worldY = static_cast<float>(i);
+        appendLine(IsometricUtils::worldToScreen(static_cast<float>(-gridWidth), worldY),
+                   IsometricUtils::worldToScreen(static_cast<float>(gridWidth), worldY), 1.0f, gridColor);
+    }
+
+    // Checkered floor tiles drawn over the grid, each followed by its outline
+    sf::Color tileColor1(40, 50, 60, 200);
+    sf::Color tileColor2(50, 60, 70, 200);
+    sf::Color outlineColor(70, 80, 90, 150);
+    for (int x = -gridWidth / 2; x < gridWidth / 2; ++x) {
+        for (int y = -gridHeight / 2; y < gridHeight / 2; ++y) {
+            appendTile(x, y, (x + y) % 2 == 0 ? tileColor1 : tileColor2, outlineColor, 1.0f);
+        }
+    }
+
+    // Upload once; fall back to drawing from memory if vertex buffers are unsupported
+    m_useBuffer = sf::VertexBuffer::isAvailable()
+        && m_buffer.create(m_vertices.size())
+        && m_buffer.update(m_vertices.data());
+    m_built = true;
+}
+
+void FloorMesh::draw(sf::RenderTarget& target, sf::Vector2f offset) {
+    if (!m_built) build();
+
+    sf::RenderStates states;
+    states.transform.translate(offset);
+    if (m_useBuffer) {
+        target.draw(m_buffer, states);
+    } else {
+        target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+    }
+}
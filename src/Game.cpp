@@ -1,116 +1,157 @@
 #include "Game.h"
 #include "IsometricUtils.h"
 #include "Projectile.h"
-#include "Path.h"
-#include "ShootingPattern.h"
+#include "Enemy.h"
+#include "SoundEffects.h"
 #include <iostream>
 #include <optional>
 #include <cmath>
-#include <cstdio>
-#include <SFML/Graphics/RenderTexture.hpp>
+#include <algorithm>
+#include <random>
 
 const std::string Game::WINDOW_TITLE = "Down to Earth: A Shmup With Legs";
+const std::string Game::DEFAULT_LEVEL_PATH = "assets/levels/stage1.txt";
+const std::string Game::DEFAULT_RECORD_PATH = "last_session.replay";
 
-Game::Game()
+Game::Game(float tickRate, const std::string& levelFile, const std::string& recordFile, const InputRecording* replay,
+           bool lateLatch)
     : window(sf::VideoMode(sf::Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT)), WINDOW_TITLE),
-      playerShip(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f, 300.0f),
-            deltaTime(0.0f),
-            elapsedTime(0.0f),
-            backgroundScrollX(0.0f),
-            backgroundScrollY(0.0f),
-            isRunning(true),
-            uiHasFont(false),
-            currentLevel(1) {
-    window.setFramerateLimit(60);
+      playfield(PLAY_WIDTH, PLAY_HEIGHT),
+      playScale(1),
+      sideWidth(0.0f),
+      deltaTime(0.0f),
+      tickLength(1.0f / (tickRate > 0.0f ? tickRate : DEFAULT_TICK_RATE)),
+      accumulator(0.0f),
+      recordPath(replay ? std::string() : recordFile),
+      replaying(replay != nullptr),
+      replayCursor(0),
+      lateLatch(lateLatch),
+      hasLateAim(false),
+#if SHMUP_PROFILING
+      framePairTests(0),
+#endif
+      uiHasFont(false),
+      isRunning(true) {
+    // Pace rendering with vsync only; the fixed tick keeps the simulation independent of the refresh rate
     window.setVerticalSyncEnabled(true);
     
-    // Pre-load projectile texture
-    Projectile::loadTexture();
-
-    // Attempt to load UI font (optional) - SFML3 uses openFromFile
-        if (uiFont.openFromFile("assets/fonts/Qager-zrlmw.ttf")) {
-        uiHasFont = true;
+    // Sprite sheets, font, music and sound effects load in the background; run() shows a loading screen until they are in
+    musicLoaded = false;
+    loader = std::make_unique<AssetLoader>(assets, uiFont, backgroundMusic, soundBank, jobs);
+    loader->start("assets/characters", "assets/fonts/Qager-zrlmw.ttf", {
+        "assets/sounds/music/test_song.mp3",
+        "assets/sounds/test_song.mp3",
+        "assets/sound/music/test_song.mp3",
+        "assets/sound/test_song.mp3",
+        "assets/music/test_song.mp3",
+    }, "assets/sounds");
+
+    updateLayout(window.getSize());
+
+    // A fresh seed per session, kept in the recording so the session can be replayed
+    if (replay) {
+        recording = *replay;
+        tickLength = recording.getTickLength();
     } else {
-        uiHasFont = false;
+        recording.begin(std::random_device{}(), tickLength);
+    }
+    simulation.setSeed(recording.getSeed());
+    std::string levelError;
+    if (!simulation.loadLevel(levelFile, levelError)) {
+        std::cerr << "Level " << levelError << "; using the default enemy formation" << std::endl;
+        simulation.spawnDefaultEnemies();
     }
+    if (!replay) recording.setLevelHash(simulation.getLevelHash());
+    simulation.setJobSystem(&jobs);
+#if SHMUP_PROFILING
+    simulation.setProfiler(&profiler);
+    playfield.setProfiler(&profiler);
+#endif
+}
 
-        // Attempt to load background music from common locations
-        musicLoaded = false;
-        std::vector<std::string> musicPaths = {
-            "assets/sounds/music/test_song.mp3",
-            "assets/sounds/test_song.mp3",
-            "assets/sound/music/test_song.mp3",
-            "assets/sound/test_song.mp3",
-            "assets/music/test_song.mp3",
-        };
-
-        for (const auto& p : musicPaths) {
-            if (backgroundMusic.openFromFile(p)) {
-                musicLoaded = true;
-                std::cout << "Loaded background music: " << p << std::endl;
-                break;
+bool Game::waitForAssets() {
+    // Progress bar in the middle of the window; nothing else is loaded yet (not even the font)
+    while (!loader->isReady()) {
+        while (std::optional<sf::Event> event = window.pollEvent()) {
+            if (event->is<sf::Event::Closed>()) {
+                window.close();
+                isRunning = false;
+                return false;
+            }
+            if (const auto* resized = event->getIf<sf::Event::Resized>()) {
+                updateLayout(resized->size);
             }
         }
 
-        if (musicLoaded) {
-            backgroundMusic.setLooping(true);
-            backgroundMusic.play();
-        } else {
-            std::cout << "Background music not found in expected paths." << std::endl;
-        }
-    
-    // Spawn 3 enemies on the right side of the screen that trail each other along a patrol path
-    float enemyX = WINDOW_WIDTH * 0.85f;
-    float enemyY = WINDOW_HEIGHT / 2.0f;
-
-    // Wider patrol that travels across more of the screen in a smooth loop
-    std::vector<sf::Vector2f> patrol = {
-        { WINDOW_WIDTH * 0.85f, WINDOW_HEIGHT * 0.50f },
-        { WINDOW_WIDTH * 0.60f, WINDOW_HEIGHT * 0.25f },
-        { WINDOW_WIDTH * 0.30f, WINDOW_HEIGHT * 0.50f },
-        { WINDOW_WIDTH * 0.60f, WINDOW_HEIGHT * 0.75f }
-    };
-
-    // Create three enemies staggered behind each other along the path
-    const int enemyCount = 3;
-    const float spacing = 40.0f; // pixels to stagger spawn positions
-    for (int i = 0; i < enemyCount; ++i) {
-        float spawnX = enemyX - i * spacing;
-        float spawnY = enemyY;
-        enemies.push_back(std::make_unique<Enemy>(spawnX, spawnY, 80.0f));
-
-        // Each enemy gets its own Path instance so internal position advances separately.
-        auto p = std::make_unique<Path>(patrol, 80.0f, true);
-        enemies.back()->setPath(std::move(p));
-        // Assign shooting patterns: lead enemy shoots radial bursts, followers shoot at player
-        if (i == 0) {
-            enemies.back()->setShootingPattern(makeRadialPattern(10, 3.0f, 160.0f));
-        } else {
-            // Faster fire rate for closer trailing enemies
-            float rate = 1.2f - i * 0.3f;
-            enemies.back()->setShootingPattern(makeDirectAtPlayerPattern(rate, 240.0f, 400.0f, false));
-        }
+        sf::Vector2f size(window.getSize());
+        sf::Vector2f barSize(std::min(320.0f, size.x * 0.5f), 6.0f);
+        sf::RectangleShape frame(barSize);
+        frame.setPosition(sf::Vector2f(std::floor((size.x - barSize.x) / 2.0f), std::floor(size.y / 2.0f)));
+        frame.setFillColor(sf::Color(40, 40, 70));
+        sf::RectangleShape bar(sf::Vector2f(barSize.x * loader->getProgress(), barSize.y));
+        bar.setPosition(frame.getPosition());
+        bar.setFillColor(sf::Color(200, 200, 240));
+
+        window.clear(sf::Color(20, 20, 40));
+        window.draw(frame);
+        window.draw(bar);
+        window.display();
     }
 
-    // Spawn a separate fourth enemy that uses the lingering beam pattern.
-    // This enemy is not part of the patrol path and will sit near the top-right area.
-    {
-        float bx = WINDOW_WIDTH * 0.72f;
-        float by = WINDOW_HEIGHT * 0.22f;
-        auto beamEnemy = std::make_unique<Enemy>(bx, by, 40.0f);
-        // No path set - it will use its simple wandering movement or remain mostly stationary
-        // Give it a lingering beam pattern: interval, warningDuration, beamDuration, projSpeed
-    // Use a simple direct-at-player pattern instead of the lingering beam
-    beamEnemy->setShootingPattern(makeDirectAtPlayerPattern(2.0f, 180.0f, 800.0f, true));
-        enemies.push_back(std::move(beamEnemy));
+    // Main-thread half: upload the atlas, then hand the loaded assets out
+    loader->finish();
+    Projectile::loadTexture(assets);
+    Enemy::loadTexture(assets);
+    simulation.getShip().loadTexture(assets);
+    uiHasFont = loader->hasFont();
+    hud.setFont(uiHasFont ? &uiFont : nullptr);
+    musicLoaded = loader->hasMusic();
+    if (musicLoaded) {
+        std::cout << "Loaded background music: " << loader->getMusicPath() << std::endl;
+        backgroundMusic.setLooping(true);
+        backgroundMusic.play();
     }
+    sfx = std::make_unique<SfxMixer>(soundBank);
+    sfx->setMasterVolume(SFX_VOLUME);
+    sfxStream = std::make_unique<SfxStream>(*sfx);
+    sfxStream->play();
+    loader.reset();
+    return true;
 }
 
-// Create a render texture for the retro playfield if desired. We create it lazily
-// at first render to avoid early GPU allocation issues on some systems.
-
+void Game::updateLayout(sf::Vector2u windowSize) {
+    // Largest integer scale that fits, so every playfield pixel becomes a whole square of window pixels
+    playScale = std::max(1, static_cast<int>(std::min(windowSize.x / PLAY_WIDTH, windowSize.y / PLAY_HEIGHT)));
+    float playWidth = static_cast<float>(PLAY_WIDTH * playScale);
+    float playHeight = static_cast<float>(PLAY_HEIGHT * playScale);
+    // Centered both ways so the playfield feels like an arcade viewport, but kept below the top bar when there is room
+    float spareHeight = std::max(0.0f, windowSize.y - playHeight);
+    float top = std::max(std::floor(spareHeight / 2.0f), std::min(HudLayer::TOP_BAR_HEIGHT, spareHeight));
+    playOrigin = sf::Vector2f(std::floor(std::max(0.0f, windowSize.x - playWidth) / 2.0f), top);
+    sideWidth = playOrigin.x;
+
+    // 1:1 window pixels for the panels and HUD
+    window.setView(sf::View(sf::FloatRect(sf::Vector2f(0.f, 0.f), sf::Vector2f(windowSize))));
+    hud.setLayout(windowSize, playOrigin.x, playOrigin.x + playWidth, sideWidth);
+}
 
 Game::~Game() {
+    if (!recordPath.empty()) {
+        recording.setTickCount(simulation.getTickCount());
+        if (recording.saveToFile(recordPath)) {
+            std::cout << "Recorded " << recording.getTickCount() << " ticks of input to " << recordPath << std::endl;
+        } else {
+            std::cerr << "Failed to write input recording " << recordPath << std::endl;
+        }
+    }
+
+    InputLatency::Summary latency = inputLatency.summarize();
+    if (latency.samples > 0) {
+        std::cout << "Input to present over the last " << latency.samples << " input events (ms): p50 " << latency.p50Ms
+                  << ", p95 " << latency.p95Ms << ", p99 " << latency.p99Ms << ", max " << latency.maxMs
+                  << " (late latch " << (lateLatch ? "on" : "off") << ")" << std::endl;
+    }
+
     // Stop music if playing. Wrap in try/catch to avoid exceptions escaping destructor
     try {
         if (musicLoaded) {
@@ -125,143 +166,158 @@ Game::~Game() {
 }
 
 void Game::run() {
+    if (loader && !waitForAssets()) return;
+    // Loading time is not simulation time
+    clock.restart();
+
     while (isRunning && window.isOpen()) {
         deltaTime = clock.restart().asSeconds();
-        elapsedTime += deltaTime;
-        
-        processEvents();
-        update(deltaTime);
-        render();
+        accumulator += deltaTime;
+#if SHMUP_PROFILING
+        profiler.beginFrame();
+        framePairTests = 0;
+#endif
+
+        {
+            SHMUP_PROFILE_SCOPE(&profiler, ProfilePhase::Events);
+            processEvents();
+        }
+
+        // Consume real time in fixed steps so results do not depend on the frame rate
+        int steps = 0;
+        while (accumulator >= tickLength && steps < MAX_STEPS_PER_FRAME && isRunning) {
+            update(tickLength);
+            accumulator -= tickLength;
+            ++steps;
+        }
+        // Too far behind (hitch, debugger, window drag): drop the backlog instead of spiralling
+        if (accumulator >= tickLength) {
+            accumulator = std::fmod(accumulator, tickLength);
+        }
+        // The frame's sounds go to the mixer together, so repeats across its ticks merge
+        if (sfx) sfx->flush();
+
+        if (lateLatch && isRunning) {
+            SHMUP_PROFILE_SCOPE(&profiler, ProfilePhase::Events);
+            latchLateInput();
+        }
+        if (!isRunning) break;
+        render(accumulator / tickLength);
+
+#if SHMUP_PROFILING
+        profiler.setCounters(static_cast<std::uint32_t>(simulation.getProjectiles().size()),
+                             static_cast<std::uint32_t>(simulation.getEnemies().size()),
+                             framePairTests, static_cast<std::uint32_t>(steps),
+                             static_cast<std::uint32_t>(playfield.getSpriteBatch().getDrawCallsSaved()));
+        profiler.endFrame();
+#endif
     }
 }
 
 void Game::processEvents() {
     while (std::optional<sf::Event> event = window.pollEvent()) {
+        // Stamp live input as it arrives; it is measured once a presented frame reflects it
+        if (!replaying) {
+            if (event->is<sf::Event::KeyPressed>() || event->is<sf::Event::KeyReleased>()) {
+                inputLatency.received(InputLatency::Key);
+            } else if (event->is<sf::Event::MouseMoved>() && simulation.getShip().getMode() == Ship::Mode::Ground) {
+                inputLatency.received(InputLatency::Aim);
+            }
+        }
+
         // Handle window closed event
         if (event->is<sf::Event::Closed>()) {
             window.close();
             isRunning = false;
         }
+
+        if (const auto* resized = event->getIf<sf::Event::Resized>()) {
+            updateLayout(resized->size);
+        }
         
         // Handle key press events
         if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-            playerShip.handleInput(keyPressed->code, true);
-            // Forward aim keys (IJKL) to ship for twin-stick ground mode aiming
-            playerShip.handleAimInput(keyPressed->code, true);
+            sendKey(keyPressed->code, true);
             
             if (keyPressed->code == sf::Keyboard::Key::Escape) {
                 window.close();
                 isRunning = false;
             }
+#if SHMUP_PROFILING
+            if (keyPressed->code == sf::Keyboard::Key::F3) {
+                profilerOverlay.toggle();
+            }
+#endif
+            if (keyPressed->code == sf::Keyboard::Key::F4) {
+                lateLatch = !lateLatch;
+                std::cout << "Late input latch " << (lateLatch ? "on" : "off") << std::endl;
+            }
         }
         
         // Handle key release events
         if (const auto* keyReleased = event->getIf<sf::Event::KeyReleased>()) {
-            playerShip.handleInput(keyReleased->code, false);
-            playerShip.handleAimInput(keyReleased->code, false);
+            sendKey(keyReleased->code, false);
         }
     }
 }
 
+void Game::latchLateInput() {
+    processEvents();
+    if (replaying || simulation.getShip().getMode() != Ship::Mode::Ground) return;
+    lateAim = mouseTarget();
+    hasLateAim = true;
+    inputLatency.consumed(InputLatency::Aim);
+}
+
+sf::Vector2f Game::mouseTarget() const {
+    // Window pixels to playfield pixels, then to world coordinates
+    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+    sf::Vector2f playPixel = (sf::Vector2f(mousePos) - playOrigin) / static_cast<float>(playScale);
+    sf::Vector2f worldScale = playfield.getWorldScale();
+    return sf::Vector2f(playPixel.x * worldScale.x, playPixel.y * worldScale.y);
+}
+
+void Game::sendKey(sf::Keyboard::Key key, bool isPressed) {
+    if (replaying) return;
+    // Keys reach the simulation before its next tick, so that is the tick they are recorded at
+    recording.recordKey(simulation.getTickCount(), key, isPressed);
+    simulation.handleKey(key, isPressed);
+}
+
 void Game::update(float deltaTime) {
-    // Update input state
-    playerShip.updateInput();
-    
-    // Scroll background when in air mode
-    if (playerShip.getMode() == Ship::Mode::Air) {
-        // Scroll to the left to create illusion of forward movement
-        backgroundScrollY -= SCROLL_SPEED * .5f * deltaTime;
-        
-        // Wrap scroll position between 0 and TILE_WIDTH/HEIGHT
-        while (backgroundScrollY >= IsometricUtils::TILE_HEIGHT) backgroundScrollY -= IsometricUtils::TILE_HEIGHT;
-        while (backgroundScrollY < 0.0f) backgroundScrollY += IsometricUtils::TILE_HEIGHT;
-        
-        // Add a slight vertical scroll component to enhance the isometric feel
-        backgroundScrollX -= SCROLL_SPEED * deltaTime;
-        while (backgroundScrollX >= IsometricUtils::TILE_WIDTH) backgroundScrollX -= IsometricUtils::TILE_WIDTH;
-        while (backgroundScrollX < 0.0f) backgroundScrollX += IsometricUtils::TILE_WIDTH;
-    }
-    
-    // Handle shooting (call shouldShoot each frame - it handles cooldown internally)
-    if (playerShip.shouldShoot()) {
-        sf::Vector2f shipPos = playerShip.getPosition();
-        float angle = playerShip.getForwardAngle();
-        
-        // Spawn projectile slightly forward so it doesn't overlap with ship
-        // Offset by ~30 pixels in the forward direction
-        float offsetDistance = 30.0f;
-        float spawnX = shipPos.x + std::cos(angle) * offsetDistance;
-        float spawnY = shipPos.y + std::sin(angle) * offsetDistance;
-        
-        projectiles.push_back(std::make_unique<Projectile>(spawnX, spawnY, angle));
-    }
-    
-    // Update game objects
-    playerShip.updateMouseAim(window); // Update facing based on mouse position
-    playerShip.update(deltaTime);
-    
-    // Update projectiles
-    for (auto it = projectiles.begin(); it != projectiles.end();) {
-        (*it)->update(deltaTime);
-        
-        // Remove projectiles that are off screen
-        if ((*it)->isOffScreen(WINDOW_WIDTH, WINDOW_HEIGHT)) {
-            it = projectiles.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    
-    // Update enemies (pass player position and allow enemies to spawn projectiles)
-    sf::Vector2f playerPos = playerShip.getPosition();
-    for (auto it = enemies.begin(); it != enemies.end();) {
-        (*it)->update(deltaTime, WINDOW_WIDTH, WINDOW_HEIGHT, playerPos, projectiles);
-
-        // Remove dead enemies
-        if ((*it)->isDead()) {
-            it = enemies.erase(it);
-        } else {
-            ++it;
+    if (replaying) {
+        // The recording supplies all input, and ends the game where the session ended
+        if (simulation.getTickCount() >= recording.getTickCount()) {
+            std::cout << "Replay finished after " << simulation.getTickCount() << " ticks, state hash "
+                      << std::hex << simulation.stateHash() << std::dec << std::endl;
+            isRunning = false;
+            window.close();
+            return;
         }
+        recording.apply(simulation, replayCursor);
+    } else if (simulation.getShip().getMode() == Ship::Mode::Ground) {
+        // Ground mode aims at the mouse cursor
+        sf::Vector2f target = mouseTarget();
+        recording.recordAim(simulation.getTickCount(), target);
+        simulation.setAimTarget(target);
     }
-    
-    // Check collisions between projectiles and enemies
-    checkCollisions();
 
-    // Check collisions between enemies and player ship
-    for (auto enemyIt = enemies.begin(); enemyIt != enemies.end();) {
-        {
-            // Manual AABB overlap check (SFML 3 removed FloatRect::intersects helper in some configs)
-            sf::FloatRect a = (*enemyIt)->getBounds();
-            sf::FloatRect b = playerShip.getBounds();
-            bool xOverlap = (a.position.x < b.position.x + b.size.x) && (b.position.x < a.position.x + a.size.x);
-            bool yOverlap = (a.position.y < b.position.y + b.size.y) && (b.position.y < a.position.y + a.size.y);
-            if (xOverlap && yOverlap) {
-                // Damage player and enemy (simple rules: both take 1)
-                playerShip.takeDamage(1);
-                (*enemyIt)->takeDamage(1);
-            }
-        }
-        ++enemyIt;
-    }
-    
-    // Keep ship within screen bounds
-    sf::Vector2f pos = playerShip.getPosition();
-    float shipRadius = 15.0f;
-    
-    if (pos.x < shipRadius) playerShip.setPosition(shipRadius, pos.y);
-    if (pos.x > WINDOW_WIDTH - shipRadius) playerShip.setPosition(WINDOW_WIDTH - shipRadius, pos.y);
-    if (pos.y < shipRadius) playerShip.setPosition(pos.x, shipRadius);
-    if (pos.y > WINDOW_HEIGHT - shipRadius) playerShip.setPosition(pos.x, WINDOW_HEIGHT - shipRadius);
+    simulation.update(deltaTime);
+    // Everything received so far is in the world the next present shows
+    inputLatency.consumed(InputLatency::Key | InputLatency::Aim);
+    if (sfx) SoundEffects::play(simulation.getTickEvents(), *sfx);
+#if SHMUP_PROFILING
+    framePairTests += static_cast<std::uint32_t>(simulation.getLastPairTests());
+#endif
 
     // End game if player health is 0
-    if (playerShip.getHealth() <= 0) {
+    if (simulation.isOver()) {
         isRunning = false;
         window.close();
     }
 }
 
-void Game::render() {
+void Game::render(float alpha) {
     // Clear with a dark background (space-like)
     window.clear(sf::Color(20, 20, 40));
 
@@ -269,342 +325,47 @@ void Game::render() {
     static bool debugPrinted = false;
     if (!debugPrinted) {
         debugPrinted = true;
-        std::cout << "Render diagnostic: projectiles=" << projectiles.size()
-                  << " enemies=" << enemies.size()
+        const Ship& playerShip = simulation.getShip();
+        std::cout << "Render diagnostic: projectiles=" << simulation.getProjectiles().size()
+                  << " enemies=" << simulation.getEnemies().size()
                   << " playerPos=(" << playerShip.getPosition().x << "," << playerShip.getPosition().y << ")"
                   << " musicLoaded=" << musicLoaded << std::endl;
     }
 
-    // Draw play area borders and UI panels
-    // Compute an integer scale for the retro play area so it scales crisply.
-    int scale = std::min(WINDOW_WIDTH / PLAY_WIDTH, WINDOW_HEIGHT / PLAY_HEIGHT);
-    if (scale < 1) scale = 1;
-    float playWidth = static_cast<float>(PLAY_WIDTH * scale);
-    float playHeight = static_cast<float>(PLAY_HEIGHT * scale);
-    float playLeft = (WINDOW_WIDTH - playWidth) / 2.0f;
-    // Center vertically as well so the playfield feels like a centered arcade viewport
-    float playTop = (WINDOW_HEIGHT - playHeight) / 2.0f;
-    float playRight = playLeft + playWidth;
-
-    // Side panels thickness
-    float sideWidth = playLeft; // left and right panel width
-
-    // Draw background for panels
-    sf::RectangleShape leftPanel(sf::Vector2f(sideWidth, static_cast<float>(WINDOW_HEIGHT)));
-    leftPanel.setPosition(sf::Vector2f(0.f, 0.f));
-    leftPanel.setFillColor(sf::Color(30, 30, 45));
-    window.draw(leftPanel);
-
-    sf::RectangleShape rightPanel(sf::Vector2f(sideWidth, static_cast<float>(WINDOW_HEIGHT)));
-    rightPanel.setPosition(sf::Vector2f(playRight, 0.f));
-    rightPanel.setFillColor(sf::Color(30, 30, 45));
-    window.draw(rightPanel);
-
-    // Draw play area bg (slightly different color)
-    sf::RectangleShape playArea(sf::Vector2f(playWidth, playHeight));
-    playArea.setPosition(sf::Vector2f(playLeft, playTop));
-    playArea.setFillColor(sf::Color(17, 154, 58));
-    window.draw(playArea);
-
-    // Draw thin top bar for HUD (time, level)
-    float topBarH = 28.0f;
-    sf::RectangleShape topBar(sf::Vector2f(static_cast<float>(WINDOW_WIDTH), topBarH));
-    topBar.setPosition(sf::Vector2f(0.f, 0.f));
-    topBar.setFillColor(sf::Color(25, 25, 40));
-    topBar.setOutlineColor(sf::Color(80, 80, 90));
-    topBar.setOutlineThickness(1.0f);
-    window.draw(topBar);
-
-    // Save current view and set a view clipped to the play area so drawFloor uses the same screen coords
-    sf::View prevView = window.getView();
-    sf::View playView = prevView;
-    // Keep the same size as the window view but translate so (0,0) for drawing maps to the play area
-    playView.setViewport(sf::FloatRect(
-        sf::Vector2f(playLeft / static_cast<float>(WINDOW_WIDTH), playTop / static_cast<float>(WINDOW_HEIGHT)),
-        sf::Vector2f(playWidth / static_cast<float>(WINDOW_WIDTH), playHeight / static_cast<float>(WINDOW_HEIGHT))
-    ));
-    window.setView(playView);
-
-    // Draw floor inside play area
-    drawFloor(window);
-
-    // Draw projectiles first (so ship appears on top)
-    for (const auto& projectile : projectiles) {
-        projectile->draw(window);
-    }
-
-    // Draw enemies
-    for (const auto& enemy : enemies) {
-        enemy->draw(window);
+    // Render the playfield at its native resolution, then blit it at the integer scale
+    if (playfield.render(simulation, alpha, hasLateAim ? &lateAim : nullptr)) {
+        sf::Sprite playSprite(playfield.getTexture());
+        playSprite.setPosition(playOrigin);
+        playSprite.setScale(sf::Vector2f(static_cast<float>(playScale), static_cast<float>(playScale)));
+        window.draw(playSprite);
     }
 
-    // Draw ship on top
-    playerShip.draw(window);
-
-    // Restore previous view to draw UI elements in screen coordinates
-    window.setView(prevView);
-
-    // Draw UI: health bar (vertical stacked) in left panel
-    float uiMargin = 16.0f;
-    float healthPanelX = uiMargin;
-    float healthPanelY = uiMargin;
-    float healthPanelW = sideWidth - uiMargin * 2.0f;
-    float healthPanelH = 120.0f;
-
-    // Panel background
-    sf::RectangleShape hpBg(sf::Vector2f(healthPanelW, healthPanelH));
-    hpBg.setPosition(sf::Vector2f(healthPanelX, healthPanelY));
-    hpBg.setFillColor(sf::Color(12, 12, 20));
-    hpBg.setOutlineColor(sf::Color(80, 80, 90));
-    hpBg.setOutlineThickness(2.0f);
-    window.draw(hpBg);
-
-    // Draw stacked HP segments (top to bottom)
-    int maxHP = 20;
-    int hp = playerShip.getHealth();
-    float segmentH = (healthPanelH - 8.0f) / static_cast<float>(maxHP);
-    for (int i = 0; i < maxHP; ++i) {
-        float segX = healthPanelX + 4.0f;
-        float segY = healthPanelY + 4.0f + i * segmentH;
-        float segW = healthPanelW - 8.0f;
-        float segH = segmentH - 4.0f;
-
-        sf::RectangleShape seg(sf::Vector2f(segW, segH));
-        seg.setPosition(sf::Vector2f(segX, segY));
-        if (i < hp) {
-            // Filled segment (from top down)
-            seg.setFillColor(sf::Color(200, 30, 30));
-        } else {
-            seg.setFillColor(sf::Color(60, 60, 70));
-        }
-        seg.setOutlineColor(sf::Color(30, 30, 40));
-        seg.setOutlineThickness(1.0f);
-        window.draw(seg);
-    }
-
-    // Draw ship mode below the HP panel
-    if (uiHasFont) {
-        std::string modeStr = (playerShip.getMode() == Ship::Mode::Air) ? "MODE: AIR" : "MODE: GROUND";
-        sf::Text modeText(uiFont, modeStr, 14);
-        modeText.setFillColor(sf::Color::White);
-        modeText.setPosition(sf::Vector2f(healthPanelX, healthPanelY + healthPanelH + 8.0f));
-        window.draw(modeText);
+    // Side panels, top bar, HP, mode, weapons, time and level: cached, one quad unless something changed
+    {
+        SHMUP_PROFILE_SCOPE(&profiler, ProfilePhase::Hud);
+        const Ship& playerShip = simulation.getShip();
+        HudState hudState;
+        hudState.health = playerShip.getHealth();
+        hudState.maxHealth = 20;
+        hudState.groundMode = playerShip.getMode() == Ship::Mode::Ground;
+        hudState.seconds = static_cast<int>(simulation.getElapsedTime());
+        hudState.level = simulation.getCurrentLevel();
+        hud.update(hudState);
+        hud.draw(window);
     }
 
-    // Right panel: show weapon slots (primary, special, defense) and top bar shows time/level
-    if (uiHasFont) {
-        // Weapons stacked vertically on the right panel
-        float weaponX = playRight + uiMargin;
-        float weaponY = uiMargin;
-        float iconW = healthPanelW;
-        float iconH = 28.0f;
-
-        auto drawWeapon = [&](const std::string &name, const sf::Color &col, float yOff) {
-            sf::RectangleShape icon(sf::Vector2f(iconW, iconH));
-            icon.setPosition(sf::Vector2f(weaponX, weaponY + yOff));
-            icon.setFillColor(col);
-            icon.setOutlineColor(sf::Color(30, 30, 40));
-            icon.setOutlineThickness(1.0f);
-            window.draw(icon);
-
-            sf::Text t(uiFont, name, 14);
-            t.setFillColor(sf::Color::White);
-            t.setPosition(sf::Vector2f(weaponX + 6.0f, weaponY + yOff + 6.0f));
-            window.draw(t);
-        };
-
-        drawWeapon("Primary", sf::Color(160,160,200), 0.0f);
-        drawWeapon("Special", sf::Color(200,160,160), iconH + 6.0f);
-        drawWeapon("Defense", sf::Color(160,200,160), 2*(iconH + 6.0f));
-
-        // Draw time and level on the top bar
-        char buf[64];
-        int seconds = static_cast<int>(elapsedTime);
-        std::snprintf(buf, sizeof(buf), "%02d:%02d", seconds / 60, seconds % 60);
-        sf::Text timeText(uiFont, buf, 14);
-        timeText.setFillColor(sf::Color::White);
-        timeText.setPosition(sf::Vector2f(playLeft + 8.0f, 4.0f));
-        window.draw(timeText);
-
-        char buf2[32];
-        std::snprintf(buf2, sizeof(buf2), "Level %d", currentLevel);
-        sf::Text levelText(uiFont, buf2, 14);
-        levelText.setFillColor(sf::Color::White);
-        // Right-align level text on top bar
-        levelText.setPosition(sf::Vector2f(playRight - 80.0f, 4.0f));
-        window.draw(levelText);
-    }
+#if SHMUP_PROFILING
+    // Right edge of the window, under the top bar
+    profilerOverlay.draw(window, profiler,
+                         sf::Vector2f(window.getSize().x - ProfilerOverlay::WIDTH - 4.0f, 32.0f),
+                         uiHasFont ? &uiFont : nullptr, &inputLatency);
+#endif
 
     // Display everything
-    window.display();
-}
-
-void Game::drawFloor(sf::RenderWindow& window) {
-    // Draw an isometric floor grid
-    // We'll create a diamond/tile pattern using the isometric projection
-    
-    sf::VertexArray gridLines(sf::PrimitiveType::Lines);
-    sf::Color gridColor(60, 60, 80, 180); // Semi-transparent grid
-    
-    // Draw grid lines in isometric space using tile units (not pixel-multiplied coordinates)
-    // We need to cover the visible area with isometric tiles
-    int gridWidth = FLOOR_GRID_SIZE;
-    int gridHeight = FLOOR_GRID_SIZE;
-
-    // Offset to center the grid and apply scroll offsets
-    float offsetX = WINDOW_WIDTH / 2.0f + backgroundScrollX;
-    float offsetY = WINDOW_HEIGHT / 3.0f - backgroundScrollY; // Position floor in lower portion of screen
-
-    // Draw vertical lines (constant worldX, varying worldY)
-    for (int i = -gridWidth; i <= gridWidth; ++i) {
-        float worldX = static_cast<float>(i); // tile units
-
-        // Top point (tile units)
-        float worldY1 = static_cast<float>(-gridHeight);
-        sf::Vector2f screen1 = IsometricUtils::worldToScreen(worldX, worldY1);
-        screen1.x += offsetX;
-        screen1.y += offsetY;
-
-        // Bottom point (tile units)
-        float worldY2 = static_cast<float>(gridHeight);
-        sf::Vector2f screen2 = IsometricUtils::worldToScreen(worldX, worldY2);
-        screen2.x += offsetX;
-        screen2.y += offsetY;
-
-        sf::Vertex v1;
-        v1.position = screen1;
-        v1.color = gridColor;
-        sf::Vertex v2;
-        v2.position = screen2;
-        v2.color = gridColor;
-        gridLines.append(v1);
-        gridLines.append(v2);
-    }
-
-    // Draw horizontal lines (constant worldY, varying worldX)
-    for (int i = -gridHeight; i <= gridHeight; ++i) {
-        float worldY = static_cast<float>(i); // tile units
-
-        // Left point
-        float worldX1 = static_cast<float>(-gridWidth);
-        sf::Vector2f screen1 = IsometricUtils::worldToScreen(worldX1, worldY);
-        screen1.x += offsetX;
-        screen1.y += offsetY;
-
-        // Right point
-        float worldX2 = static_cast<float>(gridWidth);
-        sf::Vector2f screen2 = IsometricUtils::worldToScreen(worldX2, worldY);
-        screen2.x += offsetX;
-        screen2.y += offsetY;
-
-        sf::Vertex v1;
-        v1.position = screen1;
-        v1.color = gridColor;
-        sf::Vertex v2;
-        v2.position = screen2;
-        v2.color = gridColor;
-        gridLines.append(v1);
-        gridLines.append(v2);
-    }
-    
-    window.draw(gridLines);
-    
-    // Draw some floor tiles for better visual effect
-    sf::Color tileColor1(40, 50, 60, 200);
-    sf::Color tileColor2(50, 60, 70, 200);
-    
-    for (int x = -gridWidth / 2; x < gridWidth / 2; ++x) {
-        for (int y = -gridHeight / 2; y < gridHeight / 2; ++y) {
-            // Use tile-unit coordinates (x,y) rather than multiplying by TILE_WIDTH/TILE_HEIGHT
-            float worldX = static_cast<float>(x);
-            float worldY = static_cast<float>(y);
-            
-            // Create a diamond shape for each tile
-            sf::ConvexShape tile;
-            tile.setPointCount(4);
-            
-            // Calculate the four corners of the isometric tile
-            // Offset coordinates by scroll position before converting to screen space
-            float scrolledX = worldX;
-            float scrolledY = worldY;
-            
-            // Convert world coordinates to screen space with scroll offsets
-            sf::Vector2f center = IsometricUtils::worldToScreen(scrolledX, scrolledY);
-            center.x += offsetX;
-            center.y += offsetY;
-            
-            // Top corner (half tile up)
-            sf::Vector2f top = IsometricUtils::worldToScreen(scrolledX, scrolledY - 0.5f);
-            top.x += offsetX;
-            top.y += offsetY;
-            
-            // Right corner (half tile right)
-            sf::Vector2f right = IsometricUtils::worldToScreen(scrolledX + 0.5f, scrolledY);
-            right.x += offsetX;
-            right.y += offsetY;
-            
-            // Bottom corner (half tile down)
-            sf::Vector2f bottom = IsometricUtils::worldToScreen(scrolledX, scrolledY + 0.5f);
-            bottom.x += offsetX;
-            bottom.y += offsetY;
-            
-            // Left corner (half tile left)
-            sf::Vector2f left = IsometricUtils::worldToScreen(scrolledX - 0.5f, scrolledY);
-            left.x += offsetX;
-            left.y += offsetY;
-            
-            tile.setPoint(0, top - center);
-            tile.setPoint(1, right - center);
-            tile.setPoint(2, bottom - center);
-            tile.setPoint(3, left - center);
-            tile.setPosition(center);
-            tile.setFillColor((x + y) % 2 == 0 ? tileColor1 : tileColor2);
-            tile.setOutlineColor(sf::Color(70, 80, 90, 150));
-            tile.setOutlineThickness(1.0f);
-            
-            window.draw(tile);
-        }
-    }
-}
-
-void Game::checkCollisions() {
-    // Check each projectile against each enemy
-    for (auto projIt = projectiles.begin(); projIt != projectiles.end();) {
-        bool projectileHit = false;
-        // Only player-owned projectiles should damage enemies
-        if ((*projIt)->getOwner() == Projectile::Owner::Player) {
-            for (auto enemyIt = enemies.begin(); enemyIt != enemies.end();) {
-                if ((*projIt)->checkCollision((*enemyIt)->getBounds())) {
-                    // Projectile hit enemy
-                    (*enemyIt)->takeDamage(1); // Beams do 1 damage
-                    projectileHit = true;
-                    // If enemy is dead, it will be removed in the update loop
-                    break;
-                } else {
-                    ++enemyIt;
-                }
-            }
-        }
-        
-        // Remove projectile if it hit an enemy
-        if (projectileHit) {
-            projIt = projectiles.erase(projIt);
-        } else {
-            ++projIt;
-        }
-    }
-
-    // Check enemy projectiles against the player
-    for (auto projIt = projectiles.begin(); projIt != projectiles.end();) {
-        if ((*projIt)->getOwner() == Projectile::Owner::Enemy) {
-            if ((*projIt)->checkCollision(playerShip.getBounds())) {
-                // Damage player and remove projectile
-                playerShip.takeDamage(1);
-                projIt = projectiles.erase(projIt);
-                continue;
-            }
-        }
-        ++projIt;
+    {
+        SHMUP_PROFILE_SCOPE(&profiler, ProfilePhase::Display);
+        window.display();
     }
+    inputLatency.presented();
+    hasLateAim = false;
 }
-
@@ -0,0 +1,226 @@
+#include "HudLayer.h"
+#include <cstdio>
+
+namespace {
+const float UI_MARGIN = 16.0f;
+const float HEALTH_PANEL_H = 120.0f;
+const float ICON_H = 28.0f;
+const unsigned TEXT_SIZE = 14;
+const sf::Color PANEL_COLOR(30, 30, 45);
+const sf::Color TOP_BAR_COLOR(25, 25, 40);
+const sf::Color OUTLINE_COLOR(80, 80, 90);
+const sf::Color CLEAR_COLOR(0, 0, 0, 0);
+
+// Space reserved for each text field; redraws clear exactly this much
+const float MODE_LABEL_H = 20.0f;
+const float TIME_LABEL_W = 80.0f;
+const float LEVEL_LABEL_W = 80.0f;
+const float LABEL_H = 20.0f;
+}
+
+bool HudState::operator==(const HudState& other) const {
+    return health == other.health && maxHealth == other.maxHealth && groundMode == other.groundMode
+        && seconds == other.seconds && level == other.level;
+}
+
+HudLayer::HudLayer()
+    : canvasReady(false), font(nullptr), size(0, 0), playLeft(0.0f), playRight(0.0f), sideWidth(0.0f),
+      layoutDirty(true), redrawCount(0) {}
+
+void HudLayer::setLayout(sf::Vector2u windowSize, float left, float right, float side) {
+    if (windowSize == size && left == playLeft && right == playRight && side == sideWidth) return;
+    size = windowSize;
+    playLeft = left;
+    playRight = right;
+    sideWidth = side;
+    layoutDirty = true;
+}
+
+void HudLayer::setFont(const sf::Font* f) {
+    if (f == font) return;
+    font = f;
+    layoutDirty = true;
+}
+
+void HudLayer::update(const HudState& state) {
+    pending = state;
+
+    if (layoutDirty) {
+        // The render texture is created here rather than in the constructor, once the window (and its
+        // GL context) exists and the size is known
+        if (size.x == 0 || size.y == 0) return;
+        if (!canvasReady || canvas.getSize() != size) {
+            canvasReady = canvas.resize(size);
+            if (!canvasReady) return;
+        }
+        redrawAll();
+        layoutDirty = false;
+        return;
+    }
+    if (!canvasReady || pending == shown) return;
+
+    bool changed = false;
+    if (pending.health != shown.health || pending.maxHealth != shown.maxHealth) {
+        drawHealth();
+        changed = true;
+    }
+    if (pending.groundMode != shown.groundMode) {
+        drawMode();
+        changed = true;
+    }
+    if (pending.seconds != shown.seconds) {
+        drawTime();
+        changed = true;
+    }
+    if (pending.level != shown.level) {
+        drawLevel();
+        changed = true;
+    }
+    shown = pending;
+    if (changed) canvas.display();
+}
+
+void HudLayer::draw(sf::RenderTarget& target) const {
+    if (!canvasReady || layoutDirty) return;
+    sf::Sprite sprite(canvas.getTexture());
+    target.draw(sprite);
+}
+
+void HudLayer::fillRegion(const sf::FloatRect& region, sf::Color color) {
+    sf::RectangleShape rect(region.size);
+    rect.setPosition(region.position);
+    rect.setFillColor(color);
+    // Replace the pixels (alpha included) instead of blending over what was there
+    canvas.draw(rect, sf::RenderStates(sf::BlendNone));
+}
+
+void HudLayer::redrawAll() {
+    canvas.clear(CLEAR_COLOR);
+
+    // Side panels and the top bar
+    sf::RectangleShape leftPanel(sf::Vector2f(sideWidth, static_cast<float>(size.y)));
+    leftPanel.setPosition(sf::Vector2f(0.f, 0.f));
+    leftPanel.setFillColor(PANEL_COLOR);
+    canvas.draw(leftPanel);
+
+    sf::RectangleShape rightPanel(sf::Vector2f(sideWidth, static_cast<float>(size.y)));
+    rightPanel.setPosition(sf::Vector2f(playRight, 0.f));
+    rightPanel.setFillColor(PANEL_COLOR);
+    canvas.draw(rightPanel);
+
+    sf::RectangleShape topBar(sf::Vector2f(static_cast<float>(size.x), TOP_BAR_HEIGHT));
+    topBar.setPosition(sf::Vector2f(0.f, 0.f));
+    topBar.setFillColor(TOP_BAR_COLOR);
+    topBar.setOutlineColor(OUTLINE_COLOR);
+    topBar.setOutlineThickness(1.0f);
+    canvas.draw(topBar);
+
+    drawHealth();
+    drawMode();
+    drawWeapons();
+    drawTime();
+    drawLevel();
+    shown = pending;
+    canvas.display();
+}
+
+void HudLayer::drawHealth() {
+    // Health bar (vertical stacked) in the left panel
+    float healthPanelX = UI_MARGIN;
+    float healthPanelY = UI_MARGIN;
+    float healthPanelW = sideWidth - UI_MARGIN * 2.0f;
+
+    // Panel background, outline included
+    fillRegion(sf::FloatRect(sf::Vector2f(healthPanelX - 2.0f, healthPanelY - 2.0f),
+                             sf::Vector2f(healthPanelW + 4.0f, HEALTH_PANEL_H + 4.0f)), PANEL_COLOR);
+    sf::RectangleShape hpBg(sf::Vector2f(healthPanelW, HEALTH_PANEL_H));
+    hpBg.setPosition(sf::Vector2f(healthPanelX, healthPanelY));
+    hpBg.setFillColor(sf::Color(12, 12, 20));
+    hpBg.setOutlineColor(OUTLINE_COLOR);
+    hpBg.setOutlineThickness(2.0f);
+    canvas.draw(hpBg);
+
+    // Stacked HP segments (top to bottom)
+    int maxHP = pending.maxHealth > 0 ? pending.maxHealth : 1;
+    float segmentH = (HEALTH_PANEL_H - 8.0f) / static_cast<float>(maxHP);
+    sf::RectangleShape seg(sf::Vector2f(healthPanelW - 8.0f, segmentH - 4.0f));
+    seg.setOutlineColor(sf::Color(30, 30, 40));
+    seg.setOutlineThickness(1.0f);
+    for (int i = 0; i < maxHP; ++i) {
+        seg.setPosition(sf::Vector2f(healthPanelX + 4.0f, healthPanelY + 4.0f + i * segmentH));
+        // Filled segments from the top down
+        seg.setFillColor(i < pending.health ? sf::Color(200, 30, 30) : sf::Color(60, 60, 70));
+        canvas.draw(seg);
+    }
+    ++redrawCount;
+}
+
+void HudLayer::drawMode() {
+    // Ship mode below the HP panel
+    sf::Vector2f pos(UI_MARGIN, UI_MARGIN + HEALTH_PANEL_H + 8.0f);
+    fillRegion(sf::FloatRect(pos, sf::Vector2f(sideWidth - UI_MARGIN, MODE_LABEL_H)), PANEL_COLOR);
+    if (font) {
+        sf::Text modeText(*font, pending.groundMode ? "MODE: GROUND" : "MODE: AIR", TEXT_SIZE);
+        modeText.setFillColor(sf::Color::White);
+        modeText.setPosition(pos);
+        canvas.draw(modeText);
+    }
+    ++redrawCount;
+}
+
+void HudLayer::drawWeapons() {
+    if (!font) return;
+
+    // Weapon slots (primary, special, defense) stacked vertically on the right panel
+    float weaponX = playRight + UI_MARGIN;
+    float weaponY = UI_MARGIN;
+    float iconW = sideWidth - UI_MARGIN * 2.0f;
+
+    auto drawWeapon = [&](const char* name, const sf::Color& col, float yOff) {
+        sf::RectangleShape icon(sf::Vector2f(iconW, ICON_H));
+        icon.setPosition(sf::Vector2f(weaponX, weaponY + yOff));
+        icon.setFillColor(col);
+        icon.setOutlineColor(sf::Color(30, 30, 40));
+        icon.setOutlineThickness(1.0f);
+        canvas.draw(icon);
+
+        sf::Text t(*font, name, TEXT_SIZE);
+        t.setFillColor(sf::Color::White);
+        t.setPosition(sf::Vector2f(weaponX + 6.0f, weaponY + yOff + 6.0f));
+        canvas.draw(t);
+    };
+
+    drawWeapon("Primary", sf::Color(160, 160, 200), 0.0f);
+    drawWeapon("Special", sf::Color(200, 160, 160), ICON_H + 6.0f);
+    drawWeapon("Defense", sf::Color(160, 200, 160), 2 * (ICON_H + 6.0f));
+    ++redrawCount;
+}
+
+void HudLayer::drawTime() {
+    sf::Vector2f pos(playLeft + 8.0f, 4.0f);
+    fillRegion(sf::FloatRect(pos, sf::Vector2f(TIME_LABEL_W, LABEL_H)), TOP_BAR_COLOR);
+    if (font) {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%02d:%02d", pending.seconds / 60, pending.seconds % 60);
+        sf::Text timeText(*font, buf, TEXT_SIZE);
+        timeText.setFillColor(sf::Color::White);
+        timeText.setPosition(pos);
+        canvas.draw(timeText);
+    }
+    ++redrawCount;
+}
+
+void HudLayer::drawLevel() {
+    // Right-aligned on the top bar
+    sf::Vector2f pos(playRight - 80.0f, 4.0f);
+    fillRegion(sf::FloatRect(pos, sf::Vector2f(LEVEL_LABEL_W, LABEL_H)), TOP_BAR_COLOR);
+    if (font) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "Level %d", pending.level);
+        sf::Text levelText(*font, buf, TEXT_SIZE);
+        levelText.setFillColor(sf::Color::White);
+        levelText.setPosition(pos);
+        canvas.draw(levelText);
+    }
+    ++redrawCount;
+}
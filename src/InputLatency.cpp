@@ -0,0 +1,55 @@
+#include "InputLatency.h"
+#include <algorithm>
+
+InputLatency::InputLatency()
+    : pendingHead(0), pendingCount(0), samplesMs(SAMPLE_CAPACITY, 0.0f), sampleCount(0), dropped(0) {
+    sorted.reserve(SAMPLE_CAPACITY);
+}
+
+void InputLatency::received(Kind kind, Clock::time_point when) {
+    if (pendingCount == MAX_PENDING) {
+        pendingHead = (pendingHead + 1) % MAX_PENDING;
+        --pendingCount;
+        ++dropped;
+    }
+    pending[(pendingHead + pendingCount) % MAX_PENDING] = Pending{when, kind, false};
+    ++pendingCount;
+}
+
+void InputLatency::consumed(std::uint8_t kinds) {
+    for (std::size_t i = 0; i < pendingCount; ++i) {
+        Pending& event = pending[(pendingHead + i) % MAX_PENDING];
+        if (event.kind & kinds) event.consumed = true;
+    }
+}
+
+void InputLatency::presented(Clock::time_point when) {
+    // Sample the consumed events; the rest keep their order for a later frame
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < pendingCount; ++i) {
+        const Pending& event = pending[(pendingHead + i) % MAX_PENDING];
+        if (event.consumed) {
+            samplesMs[sampleCount % SAMPLE_CAPACITY] = std::chrono::duration<float, std::milli>(when - event.when).count();
+            ++sampleCount;
+        } else {
+            pending[(pendingHead + kept++) % MAX_PENDING] = event;
+        }
+    }
+    pendingCount = kept;
+}
+
+InputLatency::Summary InputLatency::summarize() const {
+    Summary summary;
+    std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(sampleCount, SAMPLE_CAPACITY));
+    if (count == 0) return summary;
+
+    sorted.assign(samplesMs.begin(), samplesMs.begin() + count);
+    std::sort(sorted.begin(), sorted.end());
+    auto at = [&](float q) { return sorted[static_cast<std::size_t>(q * (count - 1) + 0.5f)]; };
+    summary.samples = count;
+    summary.p50Ms = at(0.50f);
+    summary.p95Ms = at(0.95f);
+    summary.p99Ms = at(0.99f);
+    summary.maxMs = sorted.back();
+    return summary;
+}
@@ -0,0 +1,197 @@
+#include "InputRecording.h"
+#include "Simulation.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+const char MAGIC[4] = {'S', 'H', 'R', 'P'};
+
+// Little-endian writers and readers, so files move between machines
+void putU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+void putU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    putU32(out, static_cast<std::uint32_t>(value));
+    putU32(out, static_cast<std::uint32_t>(value >> 32));
+}
+
+void putFloat(std::vector<std::uint8_t>& out, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(out, bits);
+}
+
+// 7 bits per byte, high bit set on all but the last: tick deltas and key codes are mostly one byte
+void putVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+struct Reader {
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t pos;
+    bool ok;
+
+    std::uint8_t byte() {
+        if (pos >= size) {
+            ok = false;
+            return 0;
+        }
+        return data[pos++];
+    }
+    std::uint32_t u32() {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            value |= static_cast<std::uint32_t>(byte()) << shift;
+        }
+        return value;
+    }
+    std::uint64_t u64() {
+        std::uint64_t low = u32();
+        return low | static_cast<std::uint64_t>(u32()) << 32;
+    }
+    float f32() {
+        std::uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    std::uint32_t varint() {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 35 && ok; shift += 7) {
+            std::uint8_t b = byte();
+            value |= static_cast<std::uint32_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+};
+}
+
+InputRecording::InputRecording()
+    : seed(0), tickLength(0.0f), levelHash(0), tickCount(0), hasLastAim(false), lastAim(0.0f, 0.0f) {}
+
+void InputRecording::begin(std::uint32_t newSeed, float newTickLength) {
+    seed = newSeed;
+    tickLength = newTickLength;
+    levelHash = 0;
+    tickCount = 0;
+    events.clear();
+    hasLastAim = false;
+}
+
+void InputRecording::recordKey(std::uint32_t tick, sf::Keyboard::Key key, bool isPressed) {
+    events.push_back(InputEvent{tick, isPressed ? InputEvent::Type::KeyDown : InputEvent::Type::KeyUp, key,
+                                sf::Vector2f(0.f, 0.f)});
+}
+
+void InputRecording::recordAim(std::uint32_t tick, const sf::Vector2f& target) {
+    if (hasLastAim && target == lastAim) return;
+    hasLastAim = true;
+    lastAim = target;
+    events.push_back(InputEvent{tick, InputEvent::Type::Aim, sf::Keyboard::Key::Unknown, target});
+}
+
+void InputRecording::apply(Simulation& simulation, std::size_t& cursor) const {
+    std::uint32_t tick = simulation.getTickCount();
+    for (; cursor < events.size() && events[cursor].tick <= tick; ++cursor) {
+        const InputEvent& event = events[cursor];
+        switch (event.type) {
+        case InputEvent::Type::KeyDown:
+            simulation.handleKey(event.key, true);
+            break;
+        case InputEvent::Type::KeyUp:
+            simulation.handleKey(event.key, false);
+            break;
+        case InputEvent::Type::Aim:
+            simulation.setAimTarget(event.aim);
+            break;
+        }
+    }
+}
+
+bool InputRecording::saveToFile(const std::string& path) const {
+    // Header: magic, version, seed, tick length, level hash, tick count, event count
+    std::vector<std::uint8_t> out(MAGIC, MAGIC + sizeof(MAGIC));
+    out.push_back(FILE_VERSION);
+    putU32(out, seed);
+    putFloat(out, tickLength);
+    putU64(out, levelHash);
+    putU32(out, tickCount);
+    putU32(out, static_cast<std::uint32_t>(events.size()));
+
+    // Events: type, ticks since the previous event, then the key (offset so Unknown = -1 fits) or the aim point
+    std::uint32_t previousTick = 0;
+    for (const InputEvent& event : events) {
+        out.push_back(static_cast<std::uint8_t>(event.type));
+        putVarint(out, event.tick - previousTick);
+        previousTick = event.tick;
+        if (event.type == InputEvent::Type::Aim) {
+            putFloat(out, event.aim.x);
+            putFloat(out, event.aim.y);
+        } else {
+            putVarint(out, static_cast<std::uint32_t>(static_cast<int>(event.key) + 1));
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+bool InputRecording::loadFromFile(const std::string& path) {
+    begin(0, 0.0f);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader in{bytes.data(), bytes.size(), 0, true};
+    if (bytes.size() < sizeof(MAGIC) || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) return false;
+    in.pos = sizeof(MAGIC);
+    if (in.byte() != FILE_VERSION) return false;
+
+    std::uint32_t fileSeed = in.u32();
+    float fileTickLength = in.f32();
+    std::uint64_t fileLevelHash = in.u64();
+    std::uint32_t fileTickCount = in.u32();
+    std::uint32_t eventCount = in.u32();
+    // Every event takes at least 3 bytes; a bigger count means a damaged file, not a huge allocation
+    if (!in.ok || !(fileTickLength > 0.0f) || eventCount > (bytes.size() - in.pos) / 3) return false;
+
+    std::vector<InputEvent> loaded;
+    loaded.reserve(eventCount);
+    std::uint32_t tick = 0;
+    for (std::uint32_t e = 0; e < eventCount && in.ok; ++e) {
+        InputEvent event{0, InputEvent::Type::KeyDown, sf::Keyboard::Key::Unknown, sf::Vector2f(0.f, 0.f)};
+        std::uint8_t type = in.byte();
+        if (type > static_cast<std::uint8_t>(InputEvent::Type::Aim)) return false;
+        event.type = static_cast<InputEvent::Type>(type);
+        tick += in.varint();
+        event.tick = tick;
+        if (event.type == InputEvent::Type::Aim) {
+            event.aim.x = in.f32();
+            event.aim.y = in.f32();
+        } else {
+            event.key = static_cast<sf::Keyboard::Key>(static_cast<int>(in.varint()) - 1);
+        }
+        loaded.push_back(event);
+    }
+    if (!in.ok) return false;
+
+    begin(fileSeed, fileTickLength);
+    levelHash = fileLevelHash;
+    tickCount = fileTickCount;
+    events = std::move(loaded);
+    return true;
+}
@@ -0,0 +1,110 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem::JobSystem(std::size_t workerCount)
+    : generation(0), stopping(false) {
+    for (std::size_t t = 0; t < workerCount + 1; ++t) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    workers.reserve(workerCount);
+    for (std::size_t t = 1; t <= workerCount; ++t) {
+        workers.emplace_back(&JobSystem::workerLoop, this, t);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+std::size_t JobSystem::defaultWorkerCount() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+void JobSystem::run(std::size_t count, std::size_t grain, ChunkFn fn, void* context) {
+    std::size_t chunks = chunkCount(count, grain);
+    if (chunks == 0) return;
+
+    // Nothing to share: skip the queues and wake-ups entirely
+    if (workers.empty() || chunks == 1) {
+        for (std::size_t c = 0; c < chunks; ++c) {
+            std::size_t begin = c * grain;
+            fn(context, begin, std::min(count, begin + grain), 0);
+        }
+        return;
+    }
+
+    // Deal contiguous runs of chunks to the threads so each starts on neighbouring data
+    std::atomic<std::size_t> pending(chunks);
+    std::size_t threads = queues.size();
+    for (std::size_t t = 0; t < threads; ++t) {
+        std::size_t first = chunks * t / threads;
+        std::size_t last = chunks * (t + 1) / threads;
+        Queue& queue = *queues[t];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        // Every chunk of the previous call has been taken, so the queue can be reset
+        queue.chunks.clear();
+        queue.head = 0;
+        for (std::size_t c = first; c < last; ++c) {
+            std::size_t begin = c * grain;
+            queue.chunks.push_back(Chunk{fn, context, begin, std::min(count, begin + grain), &pending});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        ++generation;
+    }
+    wake.notify_all();
+
+    // Help out until the last chunk is done (possibly on another thread)
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!runOne(0)) std::this_thread::yield();
+    }
+}
+
+bool JobSystem::pop(std::size_t index, Chunk& out, bool steal) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.chunks.size()) return false;
+    if (steal) {
+        out = queue.chunks.back();
+        queue.chunks.pop_back();
+    } else {
+        out = queue.chunks[queue.head++];
+    }
+    return true;
+}
+
+bool JobSystem::runOne(std::size_t thread) {
+    Chunk chunk;
+    bool found = pop(thread, chunk, false);
+    // Own queue empty: steal, starting with the next thread so thieves spread out
+    for (std::size_t k = 1; !found && k < queues.size(); ++k) {
+        found = pop((thread + k) % queues.size(), chunk, true);
+    }
+    if (!found) return false;
+
+    chunk.fn(chunk.context, chunk.begin, chunk.end, thread);
+    // Last access to the chunk's call: the caller may return as soon as this reaches zero
+    chunk.pending->fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::workerLoop(std::size_t thread) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        while (runOne(thread)) {}
+    }
+}
@@ -0,0 +1,395 @@
+#include "LevelData.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SHMUP_LEVEL_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// What an unloaded LevelData points at: a valid level with nothing in it
+const LevelFormat::Header EMPTY_LEVEL = {{'S', 'H', 'L', 'V'}, LevelFormat::VERSION, 1, 0, 0, 0, 0,
+                                         sizeof(LevelFormat::Header), sizeof(LevelFormat::Header),
+                                         sizeof(LevelFormat::Header), sizeof(LevelFormat::Header),
+                                         sizeof(LevelFormat::Header), 0, 0, 0,
+                                         sizeof(LevelFormat::Header), sizeof(LevelFormat::Header),
+                                         sizeof(LevelFormat::Header)};
+
+struct Archetype {
+    float speed = 100.0f;
+    int health = 1;
+    std::int32_t pattern = -1;
+};
+
+bool parseFloat(const std::string& text, float& out) {
+    char* end = nullptr;
+    out = std::strtof(text.c_str(), &end);
+    return !text.empty() && end && *end == '\0';
+}
+
+bool parseInt(const std::string& text, int& out) {
+    char* end = nullptr;
+    long value = std::strtol(text.c_str(), &end, 10);
+    out = static_cast<int>(value);
+    return !text.empty() && end && *end == '\0';
+}
+
+template <typename T>
+void append(std::vector<std::uint8_t>& out, const std::vector<T>& records) {
+    const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(records.data());
+    out.insert(out.end(), bytes, bytes + records.size() * sizeof(T));
+}
+
+} // namespace
+
+bool compileLevel(const std::string& source, std::vector<std::uint8_t>& out, std::string& error,
+                  const std::string& baseDirectory) {
+    int levelNumber = 1;
+    std::vector<LevelFormat::Track> tracks;
+    std::vector<LevelFormat::Point> points;
+    std::vector<LevelFormat::Pattern> patterns;
+    std::vector<LevelFormat::Spawn> spawns;
+    std::map<std::string, std::int32_t> trackNames;
+    std::map<std::string, std::int32_t> patternNames;
+    std::map<std::string, Archetype> archetypes;
+    BulletProgram scripts;
+    std::map<std::string, std::int32_t> scriptFiles; // each file is compiled once however many patterns use it
+
+    std::istringstream lines(source);
+    std::string line;
+    int lineNumber = 0;
+    auto fail = [&](const std::string& what) {
+        error = "line " + std::to_string(lineNumber) + ": " + what;
+        return false;
+    };
+
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::vector<std::string> w;
+        for (std::string word; words >> word;) w.push_back(word);
+        if (w.empty()) continue;
+
+        if (w[0] == "level") {
+            if (w.size() != 2 || !parseInt(w[1], levelNumber)) return fail("expected: level <number>");
+        } else if (w[0] == "track") {
+            if (w.size() < 6 || (w.size() - 4) % 2 != 0) return fail("expected: track <name> <shape> <loop|open> <x> <y> ...");
+            if (w[2] != "polyline" && w[2] != "catmullrom") return fail("unknown track shape '" + w[2] + "'");
+            if (w[3] != "loop" && w[3] != "open") return fail("expected loop or open, got '" + w[3] + "'");
+            LevelFormat::Track track{static_cast<std::uint32_t>(points.size()), 0, w[2] == "catmullrom", w[3] == "loop"};
+            for (std::size_t k = 4; k < w.size(); k += 2) {
+                LevelFormat::Point p;
+                if (!parseFloat(w[k], p.x) || !parseFloat(w[k + 1], p.y)) return fail("bad waypoint '" + w[k] + " " + w[k + 1] + "'");
+                points.push_back(p);
+                ++track.pointCount;
+            }
+            trackNames[w[1]] = static_cast<std::int32_t>(tracks.size());
+            tracks.push_back(track);
+        } else if (w[0] == "pattern") {
+            if (w.size() < 3) return fail("expected: pattern <name> <kind> ...");
+            LevelFormat::Pattern pattern{LevelFormat::Aimed, 0, 1.0f, 200.0f, 400.0f, 0.0f, 0};
+            bool ok;
+            if (w[2] == "aimed") {
+                ok = (w.size() == 6 || (w.size() == 7 && w[6] == "always")) && parseFloat(w[3], pattern.interval)
+                     && parseFloat(w[4], pattern.speed) && parseFloat(w[5], pattern.range);
+                pattern.always = w.size() == 7;
+            } else if (w[2] == "radial") {
+                pattern.kind = LevelFormat::Radial;
+                int count = 0;
+                ok = w.size() == 6 && parseInt(w[3], count) && parseFloat(w[4], pattern.interval) && parseFloat(w[5], pattern.speed);
+                pattern.count = count;
+            } else if (w[2] == "spread") {
+                pattern.kind = LevelFormat::Spread;
+                int count = 0;
+                ok = w.size() == 7 && parseInt(w[3], count) && parseFloat(w[4], pattern.arcDegrees)
+                     && parseFloat(w[5], pattern.interval) && parseFloat(w[6], pattern.speed);
+                pattern.count = count;
+            } else if (w[2] == "script") {
+                pattern.kind = LevelFormat::Script;
+                ok = w.size() == 5 && parseFloat(w[3], pattern.interval);
+                if (ok) {
+                    std::string path = (std::filesystem::path(baseDirectory) / w[4]).string();
+                    auto found = scriptFiles.find(path);
+                    if (found == scriptFiles.end()) {
+                        std::string scriptError;
+                        if (!loadBulletScript(path, scripts, scriptError)) return fail(scriptError);
+                        found = scriptFiles.emplace(path, static_cast<std::int32_t>(scripts.scripts.size() - 1)).first;
+                    }
+                    pattern.count = found->second;
+                }
+            } else {
+                return fail("unknown pattern kind '" + w[2] + "'");
+            }
+            if (!ok) return fail("bad parameters for " + w[2] + " pattern '" + w[1] + "'");
+            patternNames[w[1]] = static_cast<std::int32_t>(patterns.size());
+            patterns.push_back(pattern);
+        } else if (w[0] == "archetype" || w[0] == "wave") {
+            bool isWave = w[0] == "wave";
+            std::size_t firstKey = isWave ? 3 : 2;
+            if (w.size() < firstKey) return fail(isWave ? "expected: wave <time> <archetype> [key=value ...]"
+                                                        : "expected: archetype <name> [key=value ...]");
+
+            // Wave defaults come from its archetype
+            Archetype base;
+            float time = 0.0f;
+            if (isWave) {
+                if (!parseFloat(w[1], time)) return fail("bad wave time '" + w[1] + "'");
+                auto found = archetypes.find(w[2]);
+                if (found == archetypes.end()) return fail("unknown archetype '" + w[2] + "'");
+                base = found->second;
+            }
+            int count = 1;
+            float delay = 0.0f, x = 0.0f, y = 0.0f, dx = 0.0f, dy = 0.0f;
+            float trackSpeed = base.speed, distance = 0.0f, spacing = 0.0f;
+            std::int32_t track = -1;
+
+            for (std::size_t k = firstKey; k < w.size(); ++k) {
+                std::size_t eq = w[k].find('=');
+                if (eq == std::string::npos) return fail("expected key=value, got '" + w[k] + "'");
+                std::string key = w[k].substr(0, eq);
+                std::string value = w[k].substr(eq + 1);
+                bool ok = true;
+                if (key == "speed") ok = parseFloat(value, base.speed);
+                else if (key == "health") ok = parseInt(value, base.health);
+                else if (key == "pattern") {
+                    auto found = patternNames.find(value);
+                    if (found == patternNames.end()) return fail("unknown pattern '" + value + "'");
+                    base.pattern = found->second;
+                } else if (!isWave) return fail("unknown archetype key '" + key + "'");
+                else if (key == "count") ok = parseInt(value, count) && count > 0;
+                else if (key == "delay") ok = parseFloat(value, delay);
+                else if (key == "x") ok = parseFloat(value, x);
+                else if (key == "y") ok = parseFloat(value, y);
+                else if (key == "dx") ok = parseFloat(value, dx);
+                else if (key == "dy") ok = parseFloat(value, dy);
+                else if (key == "track_speed") ok = parseFloat(value, trackSpeed);
+                else if (key == "distance") ok = parseFloat(value, distance);
+                else if (key == "spacing") ok = parseFloat(value, spacing);
+                else if (key == "track") {
+                    auto found = trackNames.find(value);
+                    if (found == trackNames.end()) return fail("unknown track '" + value + "'");
+                    track = found->second;
+                } else return fail("unknown wave key '" + key + "'");
+                if (!ok) return fail("bad value for " + key + ": '" + value + "'");
+            }
+
+            if (!isWave) {
+                archetypes[w[1]] = base;
+                continue;
+            }
+            for (int i = 0; i < count; ++i) {
+                float f = static_cast<float>(i);
+                spawns.push_back(LevelFormat::Spawn{time + delay * f, x + dx * f, y + dy * f, base.speed, base.health,
+                                                    track, trackSpeed, distance - spacing * f, base.pattern});
+            }
+        } else {
+            return fail("unknown directive '" + w[0] + "'");
+        }
+    }
+
+    // The spawner pops from the front as the stage clock advances; equal times keep file order
+    std::stable_sort(spawns.begin(), spawns.end(),
+                     [](const LevelFormat::Spawn& a, const LevelFormat::Spawn& b) { return a.time < b.time; });
+
+    LevelFormat::Header header;
+    std::memcpy(header.magic, LevelFormat::MAGIC, sizeof(header.magic));
+    header.version = LevelFormat::VERSION;
+    header.level = levelNumber;
+    header.trackCount = static_cast<std::uint32_t>(tracks.size());
+    header.pointCount = static_cast<std::uint32_t>(points.size());
+    header.patternCount = static_cast<std::uint32_t>(patterns.size());
+    header.spawnCount = static_cast<std::uint32_t>(spawns.size());
+    header.tracksOffset = sizeof(header);
+    header.pointsOffset = header.tracksOffset + header.trackCount * sizeof(LevelFormat::Track);
+    header.patternsOffset = header.pointsOffset + header.pointCount * sizeof(LevelFormat::Point);
+    header.spawnsOffset = header.patternsOffset + header.patternCount * sizeof(LevelFormat::Pattern);
+    header.instructionCount = static_cast<std::uint32_t>(scripts.instructions.size());
+    header.actionCount = static_cast<std::uint32_t>(scripts.actions.size());
+    header.scriptCount = static_cast<std::uint32_t>(scripts.scripts.size());
+    header.instructionsOffset = header.spawnsOffset + header.spawnCount * sizeof(LevelFormat::Spawn);
+    header.actionsOffset = header.instructionsOffset + header.instructionCount * sizeof(BulletCode::Instruction);
+    header.scriptsOffset = header.actionsOffset + header.actionCount * sizeof(BulletCode::Action);
+    header.totalSize = header.scriptsOffset + header.scriptCount * sizeof(std::uint32_t);
+
+    out.clear();
+    out.reserve(header.totalSize);
+    const std::uint8_t* headerBytes = reinterpret_cast<const std::uint8_t*>(&header);
+    out.insert(out.end(), headerBytes, headerBytes + sizeof(header));
+    append(out, tracks);
+    append(out, points);
+    append(out, patterns);
+    append(out, spawns);
+    append(out, scripts.instructions);
+    append(out, scripts.actions);
+    append(out, scripts.scripts);
+    return true;
+}
+
+LevelData::LevelData()
+    : data(reinterpret_cast<const std::uint8_t*>(&EMPTY_LEVEL)), size(sizeof(EMPTY_LEVEL)),
+      mapping(nullptr), mappingSize(0) {}
+
+LevelData::~LevelData() {
+    release();
+}
+
+void LevelData::release() {
+#if SHMUP_LEVEL_MMAP
+    if (mapping) munmap(mapping, mappingSize);
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    buffer.clear();
+    data = reinterpret_cast<const std::uint8_t*>(&EMPTY_LEVEL);
+    size = sizeof(EMPTY_LEVEL);
+}
+
+bool LevelData::loadFromFile(const std::string& path) {
+    release();
+    error.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    char magic[sizeof(LevelFormat::MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    bool compiled = file.gcount() == sizeof(magic) && std::memcmp(magic, LevelFormat::MAGIC, sizeof(magic)) == 0;
+
+    if (!compiled) {
+        // Text source: compile it into the buffer
+        file.clear();
+        file.seekg(0);
+        std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::string directory = std::filesystem::path(path).parent_path().string();
+        if (!compileLevel(source, buffer, error, directory)) {
+            error = path + ", " + error;
+            buffer.clear();
+            return false;
+        }
+    } else {
+#if SHMUP_LEVEL_MMAP
+        file.close();
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                mapping = mapped;
+                mappingSize = static_cast<std::size_t>(info.st_size);
+            }
+        }
+        if (fd >= 0) close(fd);
+        if (mapping) {
+            data = static_cast<const std::uint8_t*>(mapping);
+            size = mappingSize;
+            if (validate()) return true;
+            error = path + ": " + error;
+            release();
+            return false;
+        }
+        file.open(path, std::ios::binary);
+#endif
+        // No mapping: read the whole file in one go
+        file.seekg(0);
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    data = buffer.data();
+    size = buffer.size();
+    if (!validate()) {
+        error = path + ": " + error;
+        release();
+        return false;
+    }
+    return true;
+}
+
+bool LevelData::loadFromMemory(const std::vector<std::uint8_t>& bytes) {
+    release();
+    error.clear();
+    buffer = bytes;
+    data = buffer.data();
+    size = buffer.size();
+    if (!validate()) {
+        release();
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t LevelData::contentHash() const {
+    std::uint64_t hash = 1469598103934665603ull;
+    for (std::size_t i = 0; i < header()->totalSize; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool LevelData::validate() {
+    // Headers and records are read in place, so everything must be inside the file and aligned
+    if (size < sizeof(LevelFormat::Header) || reinterpret_cast<std::uintptr_t>(data) % alignof(LevelFormat::Header) != 0) {
+        error = "too short to be a level";
+        return false;
+    }
+    const LevelFormat::Header& h = *header();
+    if (std::memcmp(h.magic, LevelFormat::MAGIC, sizeof(h.magic)) != 0 || h.version != LevelFormat::VERSION) {
+        error = "not a compiled level of this version";
+        return false;
+    }
+    auto fits = [&](std::uint32_t offset, std::uint32_t count, std::size_t recordSize) {
+        return offset % 4 == 0 && offset <= size && count <= (size - offset) / recordSize;
+    };
+    if (h.totalSize > size || !fits(h.tracksOffset, h.trackCount, sizeof(LevelFormat::Track))
+        || !fits(h.pointsOffset, h.pointCount, sizeof(LevelFormat::Point))
+        || !fits(h.patternsOffset, h.patternCount, sizeof(LevelFormat::Pattern))
+        || !fits(h.spawnsOffset, h.spawnCount, sizeof(LevelFormat::Spawn))
+        || !fits(h.instructionsOffset, h.instructionCount, sizeof(BulletCode::Instruction))
+        || !fits(h.actionsOffset, h.actionCount, sizeof(BulletCode::Action))
+        || !fits(h.scriptsOffset, h.scriptCount, sizeof(std::uint32_t))) {
+        error = "truncated or corrupt level";
+        return false;
+    }
+    for (std::size_t t = 0; t < h.trackCount; ++t) {
+        const LevelFormat::Track& track = getTrack(t);
+        if (track.firstPoint > h.pointCount || track.pointCount > h.pointCount - track.firstPoint) {
+            error = "track " + std::to_string(t) + " points outside the point table";
+            return false;
+        }
+    }
+    for (std::size_t p = 0; p < h.patternCount; ++p) {
+        const LevelFormat::Pattern& pattern = getPattern(p);
+        if (pattern.kind == LevelFormat::Script && (pattern.count < 0 || static_cast<std::uint32_t>(pattern.count) >= h.scriptCount)) {
+            error = "pattern " + std::to_string(p) + " runs a missing script";
+            return false;
+        }
+    }
+    std::string scriptError;
+    if (!validateBulletProgram(getInstructions(), h.instructionCount, getActions(), h.actionCount,
+                               getScripts(), h.scriptCount, scriptError)) {
+        error = "bullet scripts: " + scriptError;
+        return false;
+    }
+    for (std::size_t s = 0; s < h.spawnCount; ++s) {
+        const LevelFormat::Spawn& spawn = getSpawn(s);
+        if (spawn.track >= static_cast<std::int32_t>(h.trackCount) || spawn.pattern >= static_cast<std::int32_t>(h.patternCount)
+            || (s > 0 && spawn.time < getSpawn(s - 1).time)) {
+            error = "spawn " + std::to_string(s) + " is out of order or references a missing track or pattern";
+            return false;
+        }
+    }
+    return true;
+}
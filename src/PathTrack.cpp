@@ -0,0 +1,93 @@
+#include "PathTrack.h"
+#include "IsometricUtils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Straight pieces each spline segment is measured with before resampling
+const int SPLINE_SUBDIVISIONS = 32;
+
+// Uniform Catmull-Rom between p1 and p2 at t in [0,1]
+sf::Vector2f catmullRom(const sf::Vector2f& p0, const sf::Vector2f& p1, const sf::Vector2f& p2, const sf::Vector2f& p3, float t) {
+    float t2 = t * t;
+    float t3 = t2 * t;
+    return 0.5f * ((2.0f * p1) + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2
+                   + (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+float distanceBetween(const sf::Vector2f& a, const sf::Vector2f& b) {
+    sf::Vector2f d = b - a;
+    return std::sqrt(d.x * d.x + d.y * d.y);
+}
+}
+
+PathTrack::PathTrack(const std::vector<sf::Vector2f>& waypoints, Shape shape, bool loop, float spacing)
+    : m_length(0.0f), m_step(1.0f), m_invStep(1.0f), m_invLength(0.0f), m_loop(loop) {
+    if (waypoints.empty()) {
+        m_samples.assign(2, sf::Vector2f(0.f, 0.f));
+        return;
+    }
+
+    // 1. The curve as a fine polyline: the waypoints themselves, or each spline segment cut into short pieces
+    std::vector<sf::Vector2f> fine;
+    std::size_t n = waypoints.size();
+    std::size_t segments = loop ? n : n - 1;
+    if (shape == Shape::Polyline || n < 3) {
+        fine = waypoints;
+        if (loop) fine.push_back(waypoints.front());
+    } else {
+        // Looping splines wrap their control points; open ones repeat the end points
+        auto control = [&](std::ptrdiff_t i) {
+            std::ptrdiff_t count = static_cast<std::ptrdiff_t>(n);
+            if (loop) return waypoints[static_cast<std::size_t>(((i % count) + count) % count)];
+            return waypoints[static_cast<std::size_t>(std::min(std::max<std::ptrdiff_t>(i, 0), count - 1))];
+        };
+        fine.reserve(segments * SPLINE_SUBDIVISIONS + 1);
+        for (std::size_t s = 0; s < segments; ++s) {
+            std::ptrdiff_t i = static_cast<std::ptrdiff_t>(s);
+            for (int k = 0; k < SPLINE_SUBDIVISIONS; ++k) {
+                float t = static_cast<float>(k) / SPLINE_SUBDIVISIONS;
+                fine.push_back(catmullRom(control(i - 1), control(i), control(i + 1), control(i + 2), t));
+            }
+        }
+        fine.push_back(control(static_cast<std::ptrdiff_t>(segments)));
+    }
+
+    // 2. Cumulative length along the fine polyline
+    std::vector<float> along(fine.size(), 0.0f);
+    for (std::size_t i = 1; i < fine.size(); ++i) {
+        along[i] = along[i - 1] + distanceBetween(fine[i - 1], fine[i]);
+    }
+    m_length = along.back();
+    if (m_length <= 0.0f) {
+        m_samples.assign(2, fine.front());
+        m_length = 0.0f;
+        return;
+    }
+
+    // 3. Resample at equal arc-length steps (the step is shrunk slightly so the last sample lands on the end)
+    std::size_t count = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(m_length / std::max(spacing, 0.01f))));
+    m_step = m_length / static_cast<float>(count);
+    m_invStep = 1.0f / m_step;
+    m_invLength = 1.0f / m_length;
+
+    m_samples.reserve(count + 1);
+    std::size_t piece = 1;
+    for (std::size_t k = 0; k < count; ++k) {
+        float target = m_step * static_cast<float>(k);
+        while (piece + 1 < fine.size() && along[piece] < target) ++piece;
+        float pieceLength = along[piece] - along[piece - 1];
+        float t = pieceLength > 0.0f ? (target - along[piece - 1]) / pieceLength : 0.0f;
+        m_samples.push_back(fine[piece - 1] + (fine[piece] - fine[piece - 1]) * t);
+    }
+    m_samples.push_back(fine.back());
+}
+
+PathTrack PathTrack::fromTiles(const std::vector<sf::Vector2i>& tiles, Shape shape, bool loop, float spacing) {
+    std::vector<sf::Vector2f> waypoints;
+    waypoints.reserve(tiles.size());
+    for (const sf::Vector2i& t : tiles) {
+        waypoints.push_back(IsometricUtils::tileToWorld(t));
+    }
+    return PathTrack(waypoints, shape, loop, spacing);
+}
@@ -0,0 +1,52 @@
+#include "PlayfieldRenderer.h"
+#include "Simulation.h"
+#include "Projectile.h"
+#include "Enemy.h"
+#include "Profiler.h"
+
+PlayfieldRenderer::PlayfieldRenderer(unsigned width, unsigned height)
+    : size(width, height), targetReady(false), floorMesh(FLOOR_GRID_SIZE), profiler(nullptr) {}
+
+sf::Vector2f PlayfieldRenderer::getWorldScale() const {
+    return sf::Vector2f(static_cast<float>(Simulation::WORLD_WIDTH) / size.x,
+                        static_cast<float>(Simulation::WORLD_HEIGHT) / size.y);
+}
+
+bool PlayfieldRenderer::render(const Simulation& simulation, float alpha, const sf::Vector2f* lateAim) {
+    // Created on first use so construction does not need a GL context
+    if (!targetReady) {
+        targetReady = target.resize(size);
+        if (!targetReady) return false;
+        // The whole world, squeezed onto the target
+        target.setView(sf::View(sf::FloatRect(sf::Vector2f(0.f, 0.f),
+                                              sf::Vector2f(Simulation::WORLD_WIDTH, Simulation::WORLD_HEIGHT))));
+    }
+
+    // Play area bg
+    target.clear(sf::Color(17, 154, 58));
+
+    // Draw the isometric floor grid. The geometry is static; only the scroll offset changes,
+    // so the baked mesh is simply translated to center the grid and apply the scroll.
+    {
+        SHMUP_PROFILE_SCOPE(profiler, ProfilePhase::Floor);
+        sf::Vector2f scroll = simulation.getBackgroundScroll(alpha);
+        float offsetX = Simulation::WORLD_WIDTH / 2.0f + scroll.x;
+        float offsetY = Simulation::WORLD_HEIGHT / 3.0f - scroll.y; // Position floor in lower portion of screen
+        floorMesh.draw(target, sf::Vector2f(offsetX, offsetY));
+    }
+
+    {
+        SHMUP_PROFILE_SCOPE(profiler, ProfilePhase::Sprites);
+
+        // Queue projectiles first, then enemies, then the ship on top. They share the atlas,
+        // so the whole layer stack is one draw call and queue order is draw order.
+        spriteBatch.resetStats();
+        Projectile::draw(simulation.getProjectiles(), spriteBatch, alpha);
+        Enemy::draw(simulation.getEnemies(), spriteBatch, alpha);
+        simulation.getShip().draw(spriteBatch, alpha, lateAim);
+        spriteBatch.flush(target);
+    }
+
+    target.display();
+    return true;
+}
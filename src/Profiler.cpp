@@ -0,0 +1,64 @@
+#include "Profiler.h"
+
+const char* profilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Events: return "events";
+        case ProfilePhase::Update: return "update";
+        case ProfilePhase::Projectiles: return "projectiles";
+        case ProfilePhase::Scripts: return "scripts";
+        case ProfilePhase::Collisions: return "collisions";
+        case ProfilePhase::Floor: return "floor";
+        case ProfilePhase::Sprites: return "sprites";
+        case ProfilePhase::Hud: return "hud";
+        case ProfilePhase::Display: return "display";
+        case ProfilePhase::Count: break;
+    }
+    return "?";
+}
+
+Profiler::Profiler()
+    : m_written(0), m_frameStart(std::chrono::steady_clock::now()) {}
+
+void Profiler::beginFrame() {
+    m_current = FrameProfile();
+    m_frameStart = std::chrono::steady_clock::now();
+}
+
+void Profiler::addTime(ProfilePhase phase, double seconds) {
+    m_current.phaseMs[static_cast<std::size_t>(phase)] += static_cast<float>(seconds * 1000.0);
+}
+
+void Profiler::setCounters(std::uint32_t projectiles, std::uint32_t enemies, std::uint32_t pairTests,
+                           std::uint32_t simSteps, std::uint32_t drawCallsSaved) {
+    m_current.projectiles = projectiles;
+    m_current.enemies = enemies;
+    m_current.pairTests = pairTests;
+    m_current.simSteps = simSteps;
+    m_current.drawCallsSaved = drawCallsSaved;
+}
+
+void Profiler::endFrame() {
+    m_current.frameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_frameStart).count();
+
+    std::uint64_t index = m_written.load(std::memory_order_relaxed);
+    Slot& slot = m_ring[index % CAPACITY];
+    // Mark the slot busy, copy, then publish the frame number
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.frame = m_current;
+    slot.sequence.store(index + 1, std::memory_order_release);
+    m_written.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::readFrame(std::size_t age, FrameProfile& out) const {
+    std::uint64_t written = m_written.load(std::memory_order_acquire);
+    if (age >= written || age >= CAPACITY) return false;
+
+    std::uint64_t index = written - 1 - age;
+    const Slot& slot = m_ring[index % CAPACITY];
+    if (slot.sequence.load(std::memory_order_acquire) != index + 1) return false;
+    out = slot.frame;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // The writer may have lapped us while copying
+    return slot.sequence.load(std::memory_order_relaxed) == index + 1;
+}
@@ -0,0 +1,152 @@
+#include "ProfilerOverlay.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+const float PADDING = 6.0f;
+const float GRAPH_HEIGHT = 64.0f;
+const float GRAPH_MAX_MS = ProfilerOverlay::BUDGET_MS * 2.0f; // top of the graph
+const float BAR_HEIGHT = 8.0f;
+const float BAR_SPACING = 12.0f;
+const float LINE_HEIGHT = 14.0f;
+const unsigned TEXT_SIZE = 11;
+
+std::size_t phaseIndex(ProfilePhase phase) { return static_cast<std::size_t>(phase); }
+
+// Projectiles and Scripts run inside Update, so they are shown as bars but not stacked on top of Update
+bool isStacked(ProfilePhase phase) { return phase != ProfilePhase::Projectiles && phase != ProfilePhase::Scripts; }
+}
+
+ProfilerOverlay::ProfilerOverlay()
+    : quads(sf::PrimitiveType::Triangles), visible(false) {}
+
+sf::Color ProfilerOverlay::phaseColor(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Events: return sf::Color(150, 150, 150);
+        case ProfilePhase::Update: return sf::Color(80, 160, 255);
+        case ProfilePhase::Projectiles: return sf::Color(120, 220, 255);
+        case ProfilePhase::Scripts: return sf::Color(160, 120, 255);
+        case ProfilePhase::Collisions: return sf::Color(255, 120, 60);
+        case ProfilePhase::Floor: return sf::Color(90, 200, 90);
+        case ProfilePhase::Sprites: return sf::Color(230, 210, 60);
+        case ProfilePhase::Hud: return sf::Color(200, 100, 220);
+        case ProfilePhase::Display: return sf::Color(70, 70, 110);
+        case ProfilePhase::Count: break;
+    }
+    return sf::Color::White;
+}
+
+void ProfilerOverlay::addRect(float x, float y, float w, float h, sf::Color color) {
+    if (w <= 0.0f || h <= 0.0f) return;
+    sf::Vector2f corners[4] = { {x, y}, {x + w, y}, {x + w, y + h}, {x, y + h} };
+    static const int order[6] = { 0, 1, 2, 0, 2, 3 };
+    for (int k : order) {
+        sf::Vertex v;
+        v.position = corners[k];
+        v.color = color;
+        quads.append(v);
+    }
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, const Profiler& profiler, sf::Vector2f position, const sf::Font* font,
+                           const InputLatency* latency) {
+    if (!visible) return;
+
+    const std::size_t phaseCount = phaseIndex(ProfilePhase::Count);
+    float barsHeight = phaseCount * BAR_SPACING;
+    float countersHeight = font ? (latency ? 5 : 4) * LINE_HEIGHT : 0.0f;
+    float height = PADDING * 4 + GRAPH_HEIGHT + barsHeight + countersHeight;
+
+    quads.clear();
+    addRect(position.x, position.y, WIDTH, height, sf::Color(0, 0, 0, 170));
+
+    // Frame-time graph: newest frame on the right, one column per frame stacked by phase
+    float graphLeft = position.x + PADDING;
+    float graphBottom = position.y + PADDING + GRAPH_HEIGHT;
+    float pixelsPerMs = GRAPH_HEIGHT / GRAPH_MAX_MS;
+    addRect(graphLeft, position.y + PADDING, static_cast<float>(GRAPH_FRAMES), GRAPH_HEIGHT, sf::Color(20, 20, 30, 200));
+
+    std::array<float, static_cast<std::size_t>(ProfilePhase::Count)> averageMs{};
+    int averaged = 0;
+    FrameProfile frame;
+    FrameProfile latest;
+    bool hasLatest = false;
+    for (int age = 0; age < GRAPH_FRAMES; ++age) {
+        if (!profiler.readFrame(static_cast<std::size_t>(age), frame)) continue;
+        if (!hasLatest) {
+            latest = frame;
+            hasLatest = true;
+        }
+        if (age < AVERAGE_FRAMES) {
+            for (std::size_t p = 0; p < phaseCount; ++p) averageMs[p] += frame.phaseMs[p];
+            ++averaged;
+        }
+
+        float x = graphLeft + static_cast<float>(GRAPH_FRAMES - 1 - age);
+        float y = graphBottom;
+        float stackedMs = 0.0f;
+        for (std::size_t p = 0; p < phaseCount && y > graphBottom - GRAPH_HEIGHT; ++p) {
+            ProfilePhase phase = static_cast<ProfilePhase>(p);
+            if (!isStacked(phase)) continue;
+            float h = std::min(frame.phaseMs[p] * pixelsPerMs, y - (graphBottom - GRAPH_HEIGHT));
+            addRect(x, y - h, 1.0f, h, phaseColor(phase));
+            y -= h;
+            stackedMs += frame.phaseMs[p];
+        }
+        // Untimed remainder of the frame (sleeps, driver work outside display())
+        float restH = std::min((frame.frameMs - stackedMs) * pixelsPerMs, y - (graphBottom - GRAPH_HEIGHT));
+        addRect(x, y - restH, 1.0f, restH, sf::Color(110, 110, 110));
+    }
+
+    // 60 Hz budget line
+    addRect(graphLeft, graphBottom - BUDGET_MS * pixelsPerMs, static_cast<float>(GRAPH_FRAMES), 1.0f,
+            sf::Color(255, 255, 255, 140));
+
+    // Per-phase bars: full width is the whole frame budget
+    float barsTop = graphBottom + PADDING;
+    float barMaxW = static_cast<float>(GRAPH_FRAMES) * 0.5f;
+    for (std::size_t p = 0; p < phaseCount; ++p) {
+        float ms = averaged > 0 ? averageMs[p] / averaged : 0.0f;
+        float w = std::min(ms / BUDGET_MS, 1.0f) * barMaxW;
+        float y = barsTop + p * BAR_SPACING;
+        addRect(graphLeft, y, barMaxW, BAR_HEIGHT, sf::Color(40, 40, 50));
+        addRect(graphLeft, y, w, BAR_HEIGHT, phaseColor(static_cast<ProfilePhase>(p)));
+    }
+
+    target.draw(quads);
+
+    if (!font) return;
+
+    char buf[64];
+    for (std::size_t p = 0; p < phaseCount; ++p) {
+        float ms = averaged > 0 ? averageMs[p] / averaged : 0.0f;
+        std::snprintf(buf, sizeof(buf), "%s %.2f", profilePhaseName(static_cast<ProfilePhase>(p)), ms);
+        sf::Text label(*font, buf, TEXT_SIZE);
+        label.setFillColor(sf::Color::White);
+        label.setPosition(sf::Vector2f(graphLeft + barMaxW + 4.0f, barsTop + p * BAR_SPACING - 3.0f));
+        target.draw(label);
+    }
+
+    float textY = barsTop + barsHeight + PADDING;
+    auto drawLine = [&](const char* text) {
+        sf::Text t(*font, text, TEXT_SIZE);
+        t.setFillColor(sf::Color::White);
+        t.setPosition(sf::Vector2f(graphLeft, textY));
+        target.draw(t);
+        textY += LINE_HEIGHT;
+    };
+
+    std::snprintf(buf, sizeof(buf), "frame %.2f ms (%u ticks)", latest.frameMs, latest.simSteps);
+    drawLine(buf);
+    std::snprintf(buf, sizeof(buf), "projectiles %u  enemies %u", latest.projectiles, latest.enemies);
+    drawLine(buf);
+    std::snprintf(buf, sizeof(buf), "pair tests %u", latest.pairTests);
+    drawLine(buf);
+    std::snprintf(buf, sizeof(buf), "draw calls saved %u", latest.drawCallsSaved);
+    drawLine(buf);
+    if (latency) {
+        InputLatency::Summary input = latency->summarize();
+        std::snprintf(buf, sizeof(buf), "input p50 %.1f p95 %.1f p99 %.1f ms", input.p50Ms, input.p95Ms, input.p99Ms);
+        drawLine(buf);
+    }
+}
@@ -0,0 +1,166 @@
+#include "ProjectileKernel.h"
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHMUP_KERNEL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace ProjectileKernel {
+// Defined in ProjectileKernelAvx2.cpp, the only file built with AVX2 enabled. nullptr when it was built without.
+Fn avx2Version();
+}
+
+namespace {
+
+std::atomic<ProjectileKernel::Fn> g_selected{nullptr};
+std::atomic<int> g_selectedIsa{0};
+
+bool detectAvx2() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6; // OSXSAVE, then XMM and YMM state
+    bool avx = (info[2] & (1 << 28)) != 0;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && avx && (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool cpuHasAvx2() {
+    static const bool hasAvx2 = detectAvx2();
+    return hasAvx2;
+}
+
+#if SHMUP_KERNEL_SSE2
+void integrateSse2(const ProjectileStreams& s, std::size_t begin, std::size_t end, float deltaTime, const CullBox& box) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 minX = _mm_set1_ps(box.minX);
+    const __m128 minY = _mm_set1_ps(box.minY);
+    const __m128 maxX = _mm_set1_ps(box.maxX);
+    const __m128 maxY = _mm_set1_ps(box.maxY);
+
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(s.posX + i);
+        __m128 y = _mm_loadu_ps(s.posY + i);
+        _mm_storeu_ps(s.prevX + i, x);
+        _mm_storeu_ps(s.prevY + i, y);
+        x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(s.velX + i), dt));
+        y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(s.velY + i), dt));
+        _mm_storeu_ps(s.posX + i, x);
+        _mm_storeu_ps(s.posY + i, y);
+
+        // Count used lifetimes down to zero; leave unused (negative) ones alone
+        __m128 life = _mm_loadu_ps(s.lifetime + i);
+        __m128 used = _mm_cmpge_ps(life, zero);
+        __m128 counted = _mm_max_ps(_mm_sub_ps(life, dt), zero);
+        life = _mm_or_ps(_mm_and_ps(used, counted), _mm_andnot_ps(used, life));
+        _mm_storeu_ps(s.lifetime + i, life);
+
+        __m128 cull = _mm_cmpeq_ps(life, zero);
+        cull = _mm_or_ps(cull, _mm_or_ps(_mm_cmplt_ps(x, minX), _mm_cmpgt_ps(x, maxX)));
+        cull = _mm_or_ps(cull, _mm_or_ps(_mm_cmplt_ps(y, minY), _mm_cmpgt_ps(y, maxY)));
+        int bits = _mm_movemask_ps(cull);
+        for (int k = 0; k < 4; ++k) {
+            s.cull[i + k] = static_cast<std::uint8_t>((bits >> k) & 1);
+        }
+    }
+    ProjectileKernel::integrateScalar(s, i, end, deltaTime, box);
+}
+#endif
+
+} // namespace
+
+namespace ProjectileKernel {
+
+void integrateScalar(const ProjectileStreams& s, std::size_t begin, std::size_t end, float deltaTime, const CullBox& box) {
+    for (std::size_t i = begin; i < end; ++i) {
+        float x = s.posX[i];
+        float y = s.posY[i];
+        s.prevX[i] = x;
+        s.prevY[i] = y;
+        x += s.velX[i] * deltaTime;
+        y += s.velY[i] * deltaTime;
+        s.posX[i] = x;
+        s.posY[i] = y;
+
+        // Reduce lifetime if used (lifetime < 0 means unused); zero marks it expired
+        float life = s.lifetime[i];
+        if (life >= 0.0f) {
+            life -= deltaTime;
+            if (life < 0.0f) life = 0.0f;
+            s.lifetime[i] = life;
+        }
+
+        bool offScreen = x < box.minX || x > box.maxX || y < box.minY || y > box.maxY;
+        s.cull[i] = static_cast<std::uint8_t>(life == 0.0f || offScreen);
+    }
+}
+
+Fn get(Isa isa) {
+    switch (isa) {
+    case Isa::Scalar:
+        return &integrateScalar;
+    case Isa::SSE2:
+#if SHMUP_KERNEL_SSE2
+        return &integrateSse2;
+#else
+        return nullptr;
+#endif
+    case Isa::AVX2:
+        return cpuHasAvx2() ? avx2Version() : nullptr;
+    }
+    return nullptr;
+}
+
+Isa best() {
+    if (get(Isa::AVX2)) return Isa::AVX2;
+    if (get(Isa::SSE2)) return Isa::SSE2;
+    return Isa::Scalar;
+}
+
+const char* name(Isa isa) {
+    switch (isa) {
+    case Isa::Scalar: return "scalar";
+    case Isa::SSE2: return "sse2";
+    case Isa::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+bool select(Isa isa) {
+    Fn fn = get(isa);
+    if (!fn) return false;
+    g_selectedIsa.store(static_cast<int>(isa), std::memory_order_relaxed);
+    g_selected.store(fn, std::memory_order_release);
+    return true;
+}
+
+Isa selected() {
+    if (!g_selected.load(std::memory_order_acquire)) select(best());
+    return static_cast<Isa>(g_selectedIsa.load(std::memory_order_relaxed));
+}
+
+void integrate(const ProjectileStreams& streams, std::size_t begin, std::size_t end, float deltaTime, const CullBox& box) {
+    Fn fn = g_selected.load(std::memory_order_acquire);
+    if (!fn) {
+        // First call: detect once. Racing first calls all pick the same version.
+        select(best());
+        fn = g_selected.load(std::memory_order_acquire);
+    }
+    fn(streams, begin, end, deltaTime, box);
+}
+
+} // namespace ProjectileKernel
@@ -0,0 +1,61 @@
+// AVX2 version of the projectile kernel. The build compiles this file (and only this file) with AVX2
+// enabled; ProjectileKernel::get() only hands it out after checking the CPU supports it.
+#include "ProjectileKernel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace {
+
+void integrateAvx2(const ProjectileStreams& s, std::size_t begin, std::size_t end, float deltaTime, const CullBox& box) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 minX = _mm256_set1_ps(box.minX);
+    const __m256 minY = _mm256_set1_ps(box.minY);
+    const __m256 maxX = _mm256_set1_ps(box.maxX);
+    const __m256 maxY = _mm256_set1_ps(box.maxY);
+
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(s.posX + i);
+        __m256 y = _mm256_loadu_ps(s.posY + i);
+        _mm256_storeu_ps(s.prevX + i, x);
+        _mm256_storeu_ps(s.prevY + i, y);
+        // Separate multiply and add (no FMA) to match the scalar rounding
+        x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(s.velX + i), dt));
+        y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_loadu_ps(s.velY + i), dt));
+        _mm256_storeu_ps(s.posX + i, x);
+        _mm256_storeu_ps(s.posY + i, y);
+
+        // Count used lifetimes down to zero; leave unused (negative) ones alone
+        __m256 life = _mm256_loadu_ps(s.lifetime + i);
+        __m256 used = _mm256_cmp_ps(life, zero, _CMP_GE_OQ);
+        __m256 counted = _mm256_max_ps(_mm256_sub_ps(life, dt), zero);
+        life = _mm256_blendv_ps(life, counted, used);
+        _mm256_storeu_ps(s.lifetime + i, life);
+
+        __m256 cull = _mm256_cmp_ps(life, zero, _CMP_EQ_OQ);
+        cull = _mm256_or_ps(cull, _mm256_or_ps(_mm256_cmp_ps(x, minX, _CMP_LT_OQ), _mm256_cmp_ps(x, maxX, _CMP_GT_OQ)));
+        cull = _mm256_or_ps(cull, _mm256_or_ps(_mm256_cmp_ps(y, minY, _CMP_LT_OQ), _mm256_cmp_ps(y, maxY, _CMP_GT_OQ)));
+
+        int bits = _mm256_movemask_ps(cull);
+        for (int k = 0; k < 8; ++k) {
+            s.cull[i + k] = static_cast<std::uint8_t>((bits >> k) & 1);
+        }
+    }
+    ProjectileKernel::integrateScalar(s, i, end, deltaTime, box);
+}
+
+} // namespace
+
+namespace ProjectileKernel {
+Fn avx2Version() { return &integrateAvx2; }
+}
+
+#else
+
+namespace ProjectileKernel {
+Fn avx2Version() { return nullptr; }
+}
+
+#endif
@@ -0,0 +1,238 @@
+#include "ProjectilePool.h"
+#include "ProjectileKernel.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Enemy sprites are drawn rotated by ROTATION_OFFSET_DEG from their travel direction
+const float OFFSET_COS = std::cos(Projectile::ROTATION_OFFSET_DEG * 3.14159265f / 180.0f);
+const float OFFSET_SIN = std::sin(Projectile::ROTATION_OFFSET_DEG * 3.14159265f / 180.0f);
+// Projectiles are culled this far outside the screen
+const float CULL_MARGIN = 50.0f;
+}
+
+ProjectileSpawnBatch::ProjectileSpawnBatch(std::size_t reserveCount) {
+    reserve(reserveCount);
+}
+
+void ProjectileSpawnBatch::reserve(std::size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_dirX.reserve(count);
+    m_dirY.reserve(count);
+    m_speed.reserve(count);
+    m_lifetime.reserve(count);
+    m_owner.reserve(count);
+    m_launches.reserve(count);
+}
+
+void ProjectileSpawnBatch::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_dirX.clear();
+    m_dirY.clear();
+    m_speed.clear();
+    m_lifetime.clear();
+    m_owner.clear();
+    m_launches.clear();
+}
+
+ProjectilePool::ProjectilePool(std::size_t capacity)
+    : m_capacity(capacity), m_size(0),
+      m_posX(capacity), m_posY(capacity), m_prevX(capacity), m_prevY(capacity), m_velX(capacity), m_velY(capacity),
+      m_lifetime(capacity), m_animTimer(capacity), m_rotCos(capacity), m_rotSin(capacity), m_halfExtent(capacity),
+      m_frame(capacity), m_cull(capacity, 0), m_owner(capacity), m_slotOf(capacity),
+      m_indexOf(capacity), m_generation(capacity, 0), m_freeSlots(capacity) {
+    clear();
+}
+
+void ProjectilePool::clear() {
+    m_size = 0;
+    // Hand out low slots first so handles stay small and predictable
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+        m_freeSlots[i] = static_cast<std::uint32_t>(m_capacity - 1 - i);
+        ++m_generation[i];
+    }
+}
+
+ProjectileHandle ProjectilePool::spawn(float x, float y, float angle, float speed, Projectile::Owner owner, float lifetime) {
+    float dirY, dirX;
+    FastMath::sinCos(angle, dirY, dirX);
+    return spawnDirected(x, y, dirX, dirY, speed, owner, lifetime);
+}
+
+ProjectileHandle ProjectilePool::spawnDirected(float x, float y, float dirX, float dirY, float speed,
+                                               Projectile::Owner owner, float lifetime) {
+    if (m_size == m_capacity) return ProjectileHandle();
+
+    std::size_t i = m_size++;
+    ProjectileHandle handle;
+    handle.slot = initialize(i, x, y, dirX, dirY, speed, owner, lifetime);
+    handle.generation = m_generation[handle.slot];
+    return handle;
+}
+
+std::size_t ProjectilePool::spawn(const ProjectileSpawnBatch& batch) {
+    std::size_t count = std::min(batch.size(), m_capacity - m_size);
+    std::size_t first = m_size;
+    m_size += count;
+    for (std::size_t k = 0; k < count; ++k) {
+        initialize(first + k, batch.m_x[k], batch.m_y[k], batch.m_dirX[k], batch.m_dirY[k],
+                   batch.m_speed[k], batch.m_owner[k], batch.m_lifetime[k]);
+    }
+    return count;
+}
+
+std::uint32_t ProjectilePool::initialize(std::size_t i, float x, float y, float dirX, float dirY, float speed,
+                                         Projectile::Owner owner, float lifetime) {
+    // Pop a free slot (the stack holds capacity - i entries before this one is taken)
+    std::uint32_t slot = m_freeSlots[m_capacity - i - 1];
+
+    m_posX[i] = x;
+    m_posY[i] = y;
+    m_prevX[i] = x;
+    m_prevY[i] = y;
+    m_velX[i] = dirX * speed;
+    m_velY[i] = dirY * speed;
+    m_lifetime[i] = lifetime;
+    m_animTimer[i] = 0.0f;
+    m_frame[i] = 0;
+    m_cull[i] = 0;
+    m_owner[i] = owner;
+    orient(i, dirX, dirY);
+
+    m_slotOf[i] = slot;
+    m_indexOf[slot] = static_cast<std::uint32_t>(i);
+    return slot;
+}
+
+void ProjectilePool::orient(std::size_t i, float dirX, float dirY) {
+    // Enemy shots are rotated to align with their travel direction. Velocity only changes when a
+    // script steers the projectile, so the rotation and the rotated hit box are cached until then.
+    float halfSize = Projectile::FRAME_SIZE / 2.0f;
+    if (m_owner[i] == Projectile::Owner::Enemy) {
+        float c = dirX * OFFSET_COS - dirY * OFFSET_SIN;
+        float s = dirX * OFFSET_SIN + dirY * OFFSET_COS;
+        m_rotCos[i] = c;
+        m_rotSin[i] = s;
+        m_halfExtent[i] = halfSize * (std::abs(c) + std::abs(s));
+    } else {
+        m_rotCos[i] = 1.0f;
+        m_rotSin[i] = 0.0f;
+        m_halfExtent[i] = halfSize;
+    }
+}
+
+void ProjectilePool::steer(std::size_t index, float dirX, float dirY, float speed) {
+    if (index >= m_size) return;
+    m_velX[index] = dirX * speed;
+    m_velY[index] = dirY * speed;
+    orient(index, dirX, dirY);
+}
+
+void ProjectilePool::remove(std::size_t index) {
+    if (index >= m_size) return;
+
+    std::uint32_t slot = m_slotOf[index];
+    ++m_generation[slot];
+
+    std::size_t last = --m_size;
+    if (index != last) {
+        m_posX[index] = m_posX[last];
+        m_posY[index] = m_posY[last];
+        m_prevX[index] = m_prevX[last];
+        m_prevY[index] = m_prevY[last];
+        m_velX[index] = m_velX[last];
+        m_velY[index] = m_velY[last];
+        m_lifetime[index] = m_lifetime[last];
+        m_animTimer[index] = m_animTimer[last];
+        m_rotCos[index] = m_rotCos[last];
+        m_rotSin[index] = m_rotSin[last];
+        m_halfExtent[index] = m_halfExtent[last];
+        m_frame[index] = m_frame[last];
+        m_cull[index] = m_cull[last];
+        m_owner[index] = m_owner[last];
+        m_slotOf[index] = m_slotOf[last];
+        m_indexOf[m_slotOf[index]] = static_cast<std::uint32_t>(index);
+    }
+
+    // Push the slot back on the free stack
+    m_freeSlots[m_capacity - m_size - 1] = slot;
+}
+
+bool ProjectilePool::remove(ProjectileHandle handle) {
+    std::size_t index = indexOf(handle);
+    if (index == m_size) return false;
+    remove(index);
+    return true;
+}
+
+bool ProjectilePool::isAlive(ProjectileHandle handle) const {
+    return handle.slot < m_capacity && m_generation[handle.slot] == handle.generation
+        && m_indexOf[handle.slot] < m_size && m_slotOf[m_indexOf[handle.slot]] == handle.slot;
+}
+
+std::size_t ProjectilePool::indexOf(ProjectileHandle handle) const {
+    return isAlive(handle) ? m_indexOf[handle.slot] : m_size;
+}
+
+ProjectileHandle ProjectilePool::handleAt(std::size_t index) const {
+    ProjectileHandle handle;
+    if (index < m_size) {
+        handle.slot = m_slotOf[index];
+        handle.generation = m_generation[handle.slot];
+    }
+    return handle;
+}
+
+void ProjectilePool::update(float deltaTime, int screenWidth, int screenHeight, std::size_t begin, std::size_t end) {
+    end = std::min(end, m_size);
+    if (begin >= end) return;
+
+    ProjectileStreams streams{m_posX.data(), m_posY.data(), m_prevX.data(), m_prevY.data(),
+                              m_velX.data(), m_velY.data(), m_lifetime.data(), m_cull.data()};
+    CullBox box{-CULL_MARGIN, -CULL_MARGIN, screenWidth + CULL_MARGIN, screenHeight + CULL_MARGIN};
+    ProjectileKernel::integrate(streams, begin, end, deltaTime, box);
+
+    for (std::size_t i = begin; i < end; ++i) {
+        // Advance to next frame if enough time has passed
+        m_animTimer[i] += deltaTime;
+        if (m_animTimer[i] >= Projectile::FRAME_DURATION) {
+            m_animTimer[i] = 0.0f;
+            m_frame[i] = static_cast<std::uint8_t>((m_frame[i] + 1) % Projectile::TOTAL_FRAMES); // Loop animation
+        }
+    }
+}
+
+void ProjectilePool::removeCulled() {
+    for (std::size_t i = 0; i < m_size;) {
+        if (m_cull[i]) {
+            remove(i); // the last projectile (and its flag) now sits at i, so do not advance
+        } else {
+            ++i;
+        }
+    }
+}
+
+float ProjectilePool::getRotation(std::size_t index) const {
+    return std::atan2(m_rotSin[index], m_rotCos[index]) * 180.0f / 3.14159265f;
+}
+
+sf::FloatRect ProjectilePool::getBounds(std::size_t index) const {
+    float h = m_halfExtent[index];
+    return sf::FloatRect(sf::Vector2f(m_posX[index] - h, m_posY[index] - h), sf::Vector2f(2.0f * h, 2.0f * h));
+}
+
+sf::FloatRect ProjectilePool::getSweptBounds(std::size_t index) const {
+    float h = m_halfExtent[index];
+    float minX = std::min(m_posX[index], m_prevX[index]) - h;
+    float minY = std::min(m_posY[index], m_prevY[index]) - h;
+    float maxX = std::max(m_posX[index], m_prevX[index]) + h;
+    float maxY = std::max(m_posY[index], m_prevY[index]) + h;
+    return sf::FloatRect(sf::Vector2f(minX, minY), sf::Vector2f(maxX - minX, maxY - minY));
+}
+
+bool ProjectilePool::checkCollision(std::size_t index, const sf::FloatRect& otherBounds) const {
+    return Projectile::checkCollision(getBounds(index), otherBounds);
+}
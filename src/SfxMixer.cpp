@@ -0,0 +1,160 @@
+#include "SfxMixer.h"
+#include "FastMath.h"
+#include <algorithm>
+
+namespace {
+
+// Merged plays get louder, up to this factor
+const float MAX_COALESCE_BOOST = 1.5f;
+const float COALESCE_BOOST_PER_PLAY = 0.1f;
+
+} // namespace
+
+SfxMixer::SfxMixer(const SoundBank& bank, std::size_t voiceCount, unsigned sampleRate)
+    : bank(bank), sampleRate(sampleRate), pending(bank.size()), queue(QUEUE_CAPACITY),
+      queueHead(0), queueTail(0), voices(voiceCount), mixBuffer(MIX_BLOCK * CHANNELS), nextSerial(0),
+      masterVolume(1.0f), activeVoices(0), peakVoices(0), started(0), stolen(0), dropped(0), queueDropped(0),
+      coalesced(0) {
+    pendingOrder.reserve(bank.size());
+    for (Voice& voice : voices) voice.sound = nullptr;
+}
+
+void SfxMixer::play(SoundBank::SoundId sound, float volume, float pan, float pitch, std::uint8_t priority) {
+    if (sound >= pending.size()) return;
+    Trigger& trigger = pending[sound];
+    if (trigger.count == 0) {
+        trigger = Trigger{sound, priority, 1, volume, pan, pitch};
+        pendingOrder.push_back(sound);
+        return;
+    }
+    // Same sound again this frame: one trigger, as loud as the loudest play, panned to their average
+    trigger.pan = (trigger.pan * trigger.count + pan) / (trigger.count + 1);
+    trigger.volume = std::max(trigger.volume, volume);
+    trigger.priority = std::max(trigger.priority, priority);
+    if (trigger.count < 0xFFFF) ++trigger.count;
+    coalesced.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SfxMixer::flush() {
+    std::size_t tail = queueTail.load(std::memory_order_relaxed);
+    std::size_t head = queueHead.load(std::memory_order_acquire);
+    for (SoundBank::SoundId sound : pendingOrder) {
+        Trigger& trigger = pending[sound];
+        if (tail - head == QUEUE_CAPACITY) {
+            queueDropped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            Trigger sent = trigger;
+            sent.volume *= std::min(MAX_COALESCE_BOOST, 1.0f + COALESCE_BOOST_PER_PLAY * (trigger.count - 1));
+            queue[tail % QUEUE_CAPACITY] = sent;
+            ++tail;
+        }
+        trigger.count = 0;
+    }
+    pendingOrder.clear();
+    queueTail.store(tail, std::memory_order_release);
+}
+
+SfxMixer::Stats SfxMixer::getStats() const {
+    Stats stats;
+    stats.activeVoices = activeVoices.load(std::memory_order_relaxed);
+    stats.peakVoices = peakVoices.load(std::memory_order_relaxed);
+    stats.started = started.load(std::memory_order_relaxed);
+    stats.stolen = stolen.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed) + queueDropped.load(std::memory_order_relaxed);
+    stats.coalesced = coalesced.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SfxMixer::start(const Trigger& trigger) {
+    if (trigger.sound >= bank.size() || bank.get(trigger.sound).samples.empty()) return;
+
+    Voice* target = nullptr;
+    for (Voice& voice : voices) {
+        if (!voice.sound) {
+            target = &voice;
+            break;
+        }
+    }
+    if (!target) {
+        // Lowest priority first, then the one that has played longest
+        for (Voice& voice : voices) {
+            if (!target || voice.priority < target->priority
+                || (voice.priority == target->priority
+                    && static_cast<std::int32_t>(voice.serial - target->serial) < 0)) {
+                target = &voice;
+            }
+        }
+        if (!target || target->priority > trigger.priority) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const SoundBank::Sound& sound = bank.get(trigger.sound);
+    // Equal-power pan: -1 is all left, 0 both sides at -3 dB, 1 all right
+    float pan = std::clamp(trigger.pan, -1.0f, 1.0f);
+    float right, left;
+    FastMath::sinCos((pan + 1.0f) * FastMath::PI * 0.25f, right, left);
+    double step = static_cast<double>(sound.sampleRate) / sampleRate * std::max(trigger.pitch, 0.01f);
+
+    target->sound = &sound;
+    target->position = 0;
+    target->step = static_cast<std::uint64_t>(step * 4294967296.0);
+    target->gainLeft = trigger.volume * left;
+    target->gainRight = trigger.volume * right;
+    target->serial = nextSerial++;
+    target->priority = trigger.priority;
+    started.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SfxMixer::mixVoice(Voice& voice, float* mix, std::size_t frames) {
+    const std::int16_t* samples = voice.sound->samples.data();
+    std::uint64_t count = voice.sound->samples.size();
+    const float scale = 1.0f / 32768.0f;
+    const float fraction = 1.0f / 4294967296.0f;
+    for (std::size_t f = 0; f < frames; ++f) {
+        std::uint64_t i = voice.position >> 32;
+        if (i >= count) break;
+        // Linear interpolation between neighbouring samples, for pitches other than 1
+        float a = samples[i];
+        float b = i + 1 < count ? samples[i + 1] : 0.0f;
+        float t = static_cast<float>(voice.position & 0xFFFFFFFFu) * fraction;
+        float s = (a + (b - a) * t) * scale;
+        mix[f * CHANNELS] += s * voice.gainLeft;
+        mix[f * CHANNELS + 1] += s * voice.gainRight;
+        voice.position += voice.step;
+    }
+    if ((voice.position >> 32) >= count) voice.sound = nullptr;
+}
+
+void SfxMixer::render(std::int16_t* out, std::size_t frames) {
+    // Start everything flushed since the last call
+    std::size_t head = queueHead.load(std::memory_order_relaxed);
+    std::size_t tail = queueTail.load(std::memory_order_acquire);
+    for (; head != tail; ++head) start(queue[head % QUEUE_CAPACITY]);
+    queueHead.store(head, std::memory_order_release);
+
+    // Busiest right after the new sounds started
+    std::uint32_t busy = 0;
+    for (const Voice& voice : voices) busy += voice.sound ? 1 : 0;
+    if (busy > peakVoices.load(std::memory_order_relaxed)) peakVoices.store(busy, std::memory_order_relaxed);
+
+    float gain = masterVolume.load(std::memory_order_relaxed) * 32767.0f;
+    while (frames > 0) {
+        std::size_t block = std::min(frames, MIX_BLOCK);
+        std::fill(mixBuffer.begin(), mixBuffer.begin() + block * CHANNELS, 0.0f);
+        for (Voice& voice : voices) {
+            if (voice.sound) mixVoice(voice, mixBuffer.data(), block);
+        }
+        for (std::size_t i = 0; i < block * CHANNELS; ++i) {
+            out[i] = static_cast<std::int16_t>(std::clamp(mixBuffer[i] * gain, -32768.0f, 32767.0f));
+        }
+        out += block * CHANNELS;
+        frames -= block;
+    }
+
+    busy = 0;
+    for (const Voice& voice : voices) busy += voice.sound ? 1 : 0;
+    activeVoices.store(busy, std::memory_order_relaxed);
+}
@@ -0,0 +1,16 @@
+#include "SfxStream.h"
+
+SfxStream::SfxStream(SfxMixer& mixer) : mixer(mixer), buffer(CHUNK_FRAMES * SfxMixer::CHANNELS) {
+    initialize(SfxMixer::CHANNELS, mixer.getSampleRate(), { sf::SoundChannel::FrontLeft, sf::SoundChannel::FrontRight });
+}
+
+SfxStream::~SfxStream() {
+    stop();
+}
+
+bool SfxStream::onGetData(Chunk& data) {
+    mixer.render(buffer.data(), CHUNK_FRAMES);
+    data.samples = buffer.data();
+    data.sampleCount = buffer.size();
+    return true; // endless: silence when nothing plays
+}
@@ -1,29 +1,24 @@
 #include "Ship.h"
+#include "AssetCache.h"
+#include "SpriteBatch.h"
+#include "FastMath.h"
 #include <SFML/Graphics.hpp>
 #include <cmath>
+#include <algorithm>
 
 #include <iostream>
 
 #include "IsometricUtils.h"
 
 Ship::Ship(float x, float y, float speed)
-    : position(x, y), velocity(0, 0), speed(speed), 
+    : position(x, y), previousPosition(x, y), velocity(0, 0), speed(speed), 
     moveUp(false), moveDown(false), moveLeft(false), moveRight(false),
     shootPressed(false), fireRate(0.15f), timeSinceLastShot(0.0f),
-    sprite(nullptr), health(20), mode(Mode::Air),
+    airAnimation(nullptr), groundDownDiag(nullptr), groundStraight(nullptr), groundUpDiag(nullptr),
+    health(20), mode(Mode::Air),
     facing(Facing::Down), aimUp(false), aimDown(false), aimLeft(false), aimRight(false),
     groundCurrentFrame(0), groundAnimTimer(0.0f), groundFrameDuration(0.08f) {
-    // Load ship sprite texture
-    if (loadTexture()) {
-        // Create sprite with loaded texture
-        sprite = std::make_unique<sf::Sprite>(texture);
-        
-        // Set origin to center of sprite for proper rotation and positioning
-        sf::FloatRect bounds = sprite->getLocalBounds();
-        sprite->setOrigin(sf::Vector2f(bounds.size.x / 2.0f, bounds.size.y / 2.0f));
-        
-        sprite->setPosition(position);
-    }
+    // Animations are looked up separately (loadTexture) so the ship can be simulated without a display
 }
 
 Ship::Facing Ship::getFacing() const {
@@ -69,90 +64,33 @@ Ship::Mode Ship::getMode() const {
     return mode;
 }
 
-bool Ship::loadTexture() {
-    bool any = false;
-    // Air-mode sprite (single image)
-    if (texture.loadFromFile("assets/characters/player/player_sky.png")) {
-        std::cout << "Loaded air ship texture: assets/characters/player/player_sky.png" << std::endl;
-        any = true;
-    }
-
-    // Ground-mode sprites (expected to be 6-frame horizontal sheets)
-    if (groundTexDownDiag.loadFromFile("assets/characters/player/player_ground_down_d.png")) {
-        std::cout << "Loaded ground down-diag texture" << std::endl;
-        any = true;
-    }
-    if (groundTexStraight.loadFromFile("assets/characters/player/player_ground_straight.png")) {
-        std::cout << "Loaded ground straight texture" << std::endl;
-        any = true;
-    }
-    if (groundTexUpDiag.loadFromFile("assets/characters/player/player_ground_up_d.png")) {
-        std::cout << "Loaded ground up-diag texture" << std::endl;
-        any = true;
-    }
-
-    return any;
+bool Ship::loadTexture(const AssetCache& assets) {
+    // Air-mode sprite (single image) and ground-mode sheets (6 frames each)
+    airAnimation = assets.find("player/player_sky");
+    groundDownDiag = assets.find("player/player_ground_down_d");
+    groundStraight = assets.find("player/player_ground_straight");
+    groundUpDiag = assets.find("player/player_ground_up_d");
+    return airAnimation || groundDownDiag || groundStraight || groundUpDiag;
 }
 
 void Ship::update(float deltaTime) {
+    previousPosition = position;
+
     // Update position based on velocity
     position += velocity * deltaTime;
     
     // Update shooting cooldown
     updateShooting(deltaTime);
     
-    // Note: updateMouseAim is called from Game class since we need the window
+    // Note: updateAim is called by the Simulation with the front-end's aim target
     
     // Note: Bounds checking is handled by the Game class
-    if (sprite) {
-        if (mode == Mode::Ground) {
-            // Advance ground animation
-            groundAnimTimer += deltaTime;
-            if (groundAnimTimer >= groundFrameDuration) {
-                groundAnimTimer = 0.0f;
-                groundCurrentFrame = (groundCurrentFrame + 1) % GROUND_TOTAL_FRAMES;
-            }
-
-            // Choose texture and orientation based on facing
-            const sf::Texture* useTex = nullptr;
-            float rotationDeg = 0.0f;
-            bool flipX = false;
-
-            switch (facing) {
-                case Facing::Down:
-                    useTex = &groundTexStraight; rotationDeg = 0.0f; break;
-                case Facing::Right:
-                    useTex = &groundTexStraight; rotationDeg = -90.0f; break;
-                case Facing::Up:
-                    useTex = &groundTexStraight; rotationDeg = 180.0f; break;
-                case Facing::Left:
-                    useTex = &groundTexStraight; rotationDeg = 90.0f; break;
-                case Facing::DownLeft:
-                    useTex = &groundTexDownDiag; rotationDeg = 0.0f; break;
-                case Facing::DownRight:
-                    useTex = &groundTexDownDiag; rotationDeg = 0.0f; flipX = true; break;
-                case Facing::UpRight:
-                    useTex = &groundTexUpDiag; rotationDeg = 0.0f; break;
-                case Facing::UpLeft:
-                    useTex = &groundTexUpDiag; rotationDeg = 0.0f; flipX = true; break;
-            }
-
-            if (useTex && useTex->getSize().x > 0) {
-                sprite->setTexture(*useTex, true);
-                int frameW = useTex->getSize().x / GROUND_FRAME_COLS;
-                int frameH = useTex->getSize().y / GROUND_FRAME_ROWS;
-                int col = groundCurrentFrame % GROUND_FRAME_COLS;
-                int row = groundCurrentFrame / GROUND_FRAME_COLS;
-                sprite->setTextureRect(sf::IntRect(sf::Vector2i(col * frameW, row * frameH), sf::Vector2i(frameW, frameH)));
-                sprite->setOrigin(sf::Vector2f(frameW / 2.0f, frameH / 2.0f));
-                sprite->setPosition(position);
-                sprite->setRotation(sf::degrees(rotationDeg));
-                sprite->setScale(sf::Vector2f(flipX ? -1.0f : 1.0f, 1.0f));
-            } else {
-                sprite->setPosition(position);
-            }
-        } else {
-            sprite->setPosition(position);
+    if (mode == Mode::Ground) {
+        // Advance ground animation
+        groundAnimTimer += deltaTime;
+        if (groundAnimTimer >= groundFrameDuration) {
+            groundAnimTimer = 0.0f;
+            groundCurrentFrame = (groundCurrentFrame + 1) % GROUND_TOTAL_FRAMES;
         }
     }
 }
@@ -182,14 +120,8 @@ void Ship::handleInput(const sf::Keyboard::Key& key, bool isPressed) {
             if (isPressed) {
                 Mode newMode = (mode == Mode::Air) ? Mode::Ground : Mode::Air;
                 if (newMode == Mode::Air) {
-                    // Reset sprite to use air texture and clear aim state
-                    sprite->setTexture(texture, true);
+                    // Clear aim state when taking off again
                     aimUp = aimDown = aimLeft = aimRight = false;
-                    // Reset origin and rotation for air mode
-                    sf::FloatRect bounds = sprite->getLocalBounds();
-                    sprite->setOrigin(sf::Vector2f(bounds.size.x / 2.0f, bounds.size.y / 2.0f));
-                    sprite->setRotation(sf::degrees(0.0f));
-                    sprite->setScale(sf::Vector2f(1.0f, 1.0f));
                 }
                 mode = newMode;
             }
@@ -203,38 +135,16 @@ void Ship::updateInput() {
     updateMovement();
 }
 
-void Ship::updateMouseAim(const sf::RenderWindow& window) {
+void Ship::updateAim(const sf::Vector2f& target) {
     if (mode != Mode::Ground) return;
 
-    // Get mouse position in window coordinates
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-    sf::Vector2f mouseWorldPos = window.mapPixelToCoords(mousePos);
-
-    // Calculate angle between ship and mouse
-    float dx = mouseWorldPos.x - position.x;
-    float dy = mouseWorldPos.y - position.y;
-    float angle = std::atan2(dy, dx);
-
-    setFacingFromAngle(angle);
+    // Classify the direction to the target straight into one of the eight facings
+    facing = static_cast<Facing>(FastMath::octant(target.x - position.x, target.y - position.y));
 }
 
 void Ship::setFacingFromAngle(float angle) {
-    // Convert angle to degrees for easier comparison
-    float degrees = angle * 180.0f / M_PI;
-    // Normalize to 0-360 range
-    while (degrees < 0) degrees += 360.0f;
-    while (degrees >= 360.0f) degrees -= 360.0f;
-
-    // Map angle to 8-way direction
-    // Each direction covers a 45-degree arc
-    if (degrees >= 337.5f || degrees < 22.5f) facing = Facing::Right;
-    else if (degrees >= 22.5f && degrees < 67.5f) facing = Facing::DownRight;
-    else if (degrees >= 67.5f && degrees < 112.5f) facing = Facing::Down;
-    else if (degrees >= 112.5f && degrees < 157.5f) facing = Facing::DownLeft;
-    else if (degrees >= 157.5f && degrees < 202.5f) facing = Facing::Left;
-    else if (degrees >= 202.5f && degrees < 247.5f) facing = Facing::UpLeft;
-    else if (degrees >= 247.5f && degrees < 292.5f) facing = Facing::Up;
-    else if (degrees >= 292.5f && degrees < 337.5f) facing = Facing::UpRight;
+    // Each facing covers a 45-degree arc centred on its direction, in enum order from Right
+    facing = static_cast<Facing>(FastMath::octantFromAngle(angle));
 }
 
 void Ship::updateMovement() {
@@ -250,16 +160,47 @@ void Ship::updateMovement() {
     
     // Normalize diagonal movement to maintain consistent speed
     if (velocity.x != 0.0f && velocity.y != 0.0f) {
-        float length = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
-        velocity.x = (velocity.x / length) * speed;
-        velocity.y = (velocity.y / length) * speed;
+        velocity = FastMath::normalize(velocity) * speed;
     }
 }
 
-void Ship::draw(sf::RenderWindow& window) {
-    if (sprite) {
-        window.draw(*sprite);
+void Ship::draw(SpriteBatch& batch, float alpha, const sf::Vector2f* aim) const {
+    const SpriteAnimation* animation = airAnimation;
+    std::size_t frameIndex = 0;
+    float rotationDeg = 0.0f;
+    bool flipX = false;
+    sf::Vector2f drawPosition = previousPosition + (position - previousPosition) * alpha;
+
+    if (mode == Mode::Ground) {
+        // Choose sheet and orientation based on facing
+        Facing shown = aim ? static_cast<Facing>(FastMath::octant(aim->x - drawPosition.x, aim->y - drawPosition.y)) : facing;
+        switch (shown) {
+            case Facing::Down:
+                animation = groundStraight; rotationDeg = 0.0f; break;
+            case Facing::Right:
+                animation = groundStraight; rotationDeg = -90.0f; break;
+            case Facing::Up:
+                animation = groundStraight; rotationDeg = 180.0f; break;
+            case Facing::Left:
+                animation = groundStraight; rotationDeg = 90.0f; break;
+            case Facing::DownLeft:
+                animation = groundDownDiag; rotationDeg = 0.0f; break;
+            case Facing::DownRight:
+                animation = groundDownDiag; rotationDeg = 0.0f; flipX = true; break;
+            case Facing::UpRight:
+                animation = groundUpDiag; rotationDeg = 0.0f; break;
+            case Facing::UpLeft:
+                animation = groundUpDiag; rotationDeg = 0.0f; flipX = true; break;
+        }
+        frameIndex = static_cast<std::size_t>(groundCurrentFrame);
     }
+    if (!animation || animation->empty()) return;
+
+    // Draw at the position blended between the last two ticks, pivoting on the frame center
+    const sf::IntRect& frame = animation->frame(frameIndex);
+    batch.draw(*animation->texture, frame, drawPosition,
+               sf::Vector2f(frame.size.x / 2.0f, frame.size.y / 2.0f), rotationDeg, sf::Color::White,
+               sf::Vector2f(flipX ? -1.0f : 1.0f, 1.0f));
 }
 
 sf::Vector2f Ship::getPosition() const {
@@ -269,9 +210,6 @@ sf::Vector2f Ship::getPosition() const {
 void Ship::setPosition(float x, float y) {
     position.x = x;
     position.y = y;
-    if (sprite) {
-        sprite->setPosition(position);
-    }
 }
 
 float Ship::getSpeed() const {
@@ -324,7 +262,14 @@ void Ship::takeDamage(int amount) {
 }
 
 sf::FloatRect Ship::getBounds() const {
-    if (sprite) return sprite->getGlobalBounds();
-    return sf::FloatRect(position, sf::Vector2f(0.f, 0.f));
+    // Frame-sized box centered on the ship, independent of whether a sprite exists
+    float half = FRAME_SIZE / 2.0f;
+    return sf::FloatRect(sf::Vector2f(position.x - half, position.y - half), sf::Vector2f(FRAME_SIZE, FRAME_SIZE));
 }
 
+sf::FloatRect Ship::getSweptBounds() const {
+    float half = FRAME_SIZE / 2.0f;
+    sf::Vector2f min(std::min(position.x, previousPosition.x) - half, std::min(position.y, previousPosition.y) - half);
+    sf::Vector2f max(std::max(position.x, previousPosition.x) + half, std::max(position.y, previousPosition.y) + half);
+    return sf::FloatRect(min, max - min);
+}
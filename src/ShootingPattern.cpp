@@ -1,68 +1,94 @@
 #include "ShootingPattern.h"
-#include "Projectile.h"
+#include "ProjectilePool.h"
+#include "FastMath.h"
 #include <cmath>
 #include <iostream>
+#include <vector>
 
-// Direct shot at player every fireRate seconds. Optionally only when player within activeRadius.
-class DirectAtPlayerPattern : public ShootingPattern {
-public:
-    DirectAtPlayerPattern(float fireRate = 1.0f, float projSpeed = 220.0f, float activeRadius = 400.0f, bool always = false)
-    : m_fireRate(fireRate), m_timer(0.0f), m_projSpeed(projSpeed), m_activeRadius(activeRadius), m_always(always) {}
+namespace {
+// Unit vectors for `count` directions starting at startRad and `stepRad` apart
+std::vector<sf::Vector2f> makeDirectionTable(int count, float startRad, float stepRad) {
+    std::vector<sf::Vector2f> table;
+    table.reserve(count > 0 ? count : 0);
+    for (int i = 0; i < count; ++i) {
+        float a = startRad + stepRad * i;
+        table.emplace_back(std::cos(a), std::sin(a));
+    }
+    return table;
+}
+}
+
+DirectAtPlayerPattern::DirectAtPlayerPattern(float fireRate, float projSpeed, float activeRadius, bool always)
+    : m_fireRate(fireRate), m_projSpeed(projSpeed), m_activeRadiusSquared(activeRadius * activeRadius), m_always(always) {}
 
-    void update(float deltaTime, const sf::Vector2f& enemyPos, const sf::Vector2f& playerPos,
-                std::vector<std::unique_ptr<Projectile>>& projectiles) override {
-        m_timer += deltaTime;
-        float dx = playerPos.x - enemyPos.x;
-        float dy = playerPos.y - enemyPos.y;
-        float dist2 = dx*dx + dy*dy;
-        if (!m_always && dist2 > m_activeRadius * m_activeRadius) return;
+bool DirectAtPlayerPattern::fire(const sf::Vector2f& enemyPos, const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns) const {
+    float dx = playerPos.x - enemyPos.x;
+    float dy = playerPos.y - enemyPos.y;
+    float dist2 = dx*dx + dy*dy;
+    if (!m_always && dist2 > m_activeRadiusSquared) return false;
 
-        if (m_timer >= m_fireRate) {
-            m_timer = 0.0f;
-            float angle = std::atan2(dy, dx);
-            projectiles.push_back(std::make_unique<Projectile>(enemyPos.x, enemyPos.y, angle, m_projSpeed, Projectile::Owner::Enemy));
-        }
+    if (dist2 > 0.0f) {
+        float invDist = FastMath::rsqrt(dist2);
+        spawns.emit(enemyPos.x, enemyPos.y, dx * invDist, dy * invDist, m_projSpeed);
     }
+    return true;
+}
+
+RadialPattern::RadialPattern(int count, float interval, float projSpeed)
+    : m_directions(makeDirectionTable(count, 0.0f, 2.0f * 3.14159265f / static_cast<float>(count > 0 ? count : 1))),
+      m_interval(interval), m_projSpeed(projSpeed) {}
 
-private:
-    float m_fireRate;
-    float m_timer;
-    float m_projSpeed;
-    float m_activeRadius;
-    bool m_always;
-};
+bool RadialPattern::fire(const sf::Vector2f& enemyPos, const sf::Vector2f& /*playerPos*/, ProjectileSpawnBatch& spawns) const {
+    for (const sf::Vector2f& dir : m_directions) {
+        spawns.emit(enemyPos.x, enemyPos.y, dir.x, dir.y, m_projSpeed);
+    }
+    return true;
+}
 
-// Radial burst pattern: fire N projectiles evenly around every interval
-class RadialPattern : public ShootingPattern {
-public:
-    RadialPattern(int count = 8, float interval = 2.0f, float projSpeed = 160.0f)
-    : m_count(count), m_interval(interval), m_timer(0.0f), m_projSpeed(projSpeed) {}
+SpreadPattern::SpreadPattern(int count, float arcDegrees, float interval, float projSpeed)
+    : m_interval(interval), m_projSpeed(projSpeed) {
+    float arc = arcDegrees * 3.14159265f / 180.0f;
+    float step = count > 1 ? arc / static_cast<float>(count - 1) : 0.0f;
+    m_offsets = makeDirectionTable(count, count > 1 ? -arc / 2.0f : 0.0f, step);
+}
 
-    void update(float deltaTime, const sf::Vector2f& enemyPos, const sf::Vector2f& /*playerPos*/,
-                std::vector<std::unique_ptr<Projectile>>& projectiles) override {
-        m_timer += deltaTime;
-        if (m_timer >= m_interval) {
-            m_timer = 0.0f;
-            for (int i = 0; i < m_count; ++i) {
-                float angle = (2.0f * 3.14159265f * i) / static_cast<float>(m_count);
-                projectiles.push_back(std::make_unique<Projectile>(enemyPos.x, enemyPos.y, angle, m_projSpeed, Projectile::Owner::Enemy));
-            }
-        }
+bool SpreadPattern::fire(const sf::Vector2f& enemyPos, const sf::Vector2f& playerPos, ProjectileSpawnBatch& spawns) const {
+    float dx = playerPos.x - enemyPos.x;
+    float dy = playerPos.y - enemyPos.y;
+    float dist2 = dx * dx + dy * dy;
+    if (dist2 <= 0.0f) return true;
+    float invDist = FastMath::rsqrt(dist2);
+    float ax = dx * invDist;
+    float ay = dy * invDist;
+    for (const sf::Vector2f& r : m_offsets) {
+        // Rotate the aim vector by the cached offset
+        spawns.emit(enemyPos.x, enemyPos.y, ax * r.x - ay * r.y, ax * r.y + ay * r.x, m_projSpeed);
     }
+    return true;
+}
 
-private:
-    int m_count;
-    float m_interval;
-    float m_timer;
-    float m_projSpeed;
-};
+ScriptedPattern::ScriptedPattern(std::int32_t script, float interval)
+    : m_script(script), m_interval(interval) {}
+
+bool ScriptedPattern::fire(const sf::Vector2f& enemyPos, const sf::Vector2f& /*playerPos*/, ProjectileSpawnBatch& spawns) const {
+    spawns.launch(m_script, enemyPos.x, enemyPos.y);
+    return true;
+}
 
 // Factory helpers
-std::unique_ptr<ShootingPattern> makeDirectAtPlayerPattern(float fireRate, float projSpeed, float activeRadius, bool always) {
-    return std::make_unique<DirectAtPlayerPattern>(fireRate, projSpeed, activeRadius, always);
+ShootingPattern makeDirectAtPlayerPattern(float fireRate, float projSpeed, float activeRadius, bool always) {
+    return DirectAtPlayerPattern(fireRate, projSpeed, activeRadius, always);
+}
+
+ShootingPattern makeRadialPattern(int count, float interval, float projSpeed) {
+    return RadialPattern(count, interval, projSpeed);
+}
+
+ShootingPattern makeSpreadPattern(int count, float arcDegrees, float interval, float projSpeed) {
+    return SpreadPattern(count, arcDegrees, interval, projSpeed);
 }
 
-std::unique_ptr<ShootingPattern> makeRadialPattern(int count, float interval, float projSpeed) {
-    return std::make_unique<RadialPattern>(count, interval, projSpeed);
+ShootingPattern makeScriptedPattern(std::int32_t script, float interval) {
+    return ScriptedPattern(script, interval);
 }
 // (Lingering-beam pattern removed)
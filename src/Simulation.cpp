@@ -0,0 +1,353 @@
+#include "Simulation.h"
+#include "IsometricUtils.h"
+#include "ShootingPattern.h"
+#include "PathTrack.h"
+#include "FastMath.h"
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+Simulation::Simulation(std::size_t projectileCapacity)
+    : playerShip(WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f, 300.0f),
+      projectiles(projectileCapacity),
+      bullets(projectileCapacity),
+      enemyGrid(WORLD_WIDTH, WORLD_HEIGHT, COLLISION_CELL_SIZE),
+      enemyShotGrid(WORLD_WIDTH, WORLD_HEIGHT, COLLISION_CELL_SIZE),
+      queryContexts(1),
+      lastPairTests(0),
+      profiler(nullptr),
+      jobs(nullptr),
+      aimTarget(0.0f, 0.0f),
+      hasAimTarget(false),
+      backgroundScrollX(0.0f),
+      backgroundScrollY(0.0f),
+      previousScrollX(0.0f),
+      previousScrollY(0.0f),
+      seed(EnemyWorld::DEFAULT_SEED),
+      tickCount(0),
+      elapsedTime(0.0f),
+      currentLevel(1) {}
+
+void Simulation::setSeed(std::uint32_t newSeed) {
+    seed = newSeed;
+    enemies.setSeed(newSeed);
+}
+
+void Simulation::setLevel(std::shared_ptr<const LevelData> newLevel) {
+    level = std::move(newLevel);
+    if (!level) return;
+    currentLevel = level->getLevelNumber();
+    bullets.setProgram(level->getInstructions(), level->getInstructionCount(), level->getActions(),
+                       level->getActionCount(), level->getScripts(), level->getScriptCount());
+    spawner.start(*level);
+    spawner.advance(0.0f, enemies);
+}
+
+bool Simulation::loadLevel(const std::string& path, std::string& error) {
+    auto loaded = std::make_shared<LevelData>();
+    if (!loaded->loadFromFile(path)) {
+        error = loaded->getError();
+        return false;
+    }
+    setLevel(std::move(loaded));
+    return true;
+}
+
+void Simulation::spawnDefaultEnemies() {
+    // Spawn 3 enemies on the right side of the screen that trail each other along a patrol path
+    // Wider patrol that travels across more of the screen in a smooth loop
+    std::vector<sf::Vector2f> patrol = {
+        { WORLD_WIDTH * 0.85f, WORLD_HEIGHT * 0.50f },
+        { WORLD_WIDTH * 0.60f, WORLD_HEIGHT * 0.25f },
+        { WORLD_WIDTH * 0.30f, WORLD_HEIGHT * 0.50f },
+        { WORLD_WIDTH * 0.60f, WORLD_HEIGHT * 0.75f }
+    };
+
+    // Tracks and patterns are stored once in the world; enemies only reference them by index
+    std::int32_t track = enemies.addTrack(std::make_shared<PathTrack>(patrol, PathTrack::Shape::CatmullRom, true));
+    std::int32_t radial = enemies.addPattern(makeRadialPattern(10, 3.0f, 160.0f));
+
+    // Create three enemies staggered behind each other along the path
+    const int enemyCount = 3;
+    const float spacing = 40.0f; // distance along the track between neighbours
+    for (int i = 0; i < enemyCount; ++i) {
+        EnemyId enemy = enemies.spawn(patrol.front().x, patrol.front().y, 80.0f);
+
+        // Same track for all three; each starts `spacing` further back than the one ahead
+        enemies.setTrack(enemy, track, 80.0f, -spacing * i);
+        // Assign shooting patterns: lead enemy shoots radial bursts, followers shoot at player
+        if (i == 0) {
+            enemies.setPattern(enemy, radial);
+        } else {
+            // Faster fire rate for closer trailing enemies
+            float rate = 1.2f - i * 0.3f;
+            enemies.setPattern(enemy, enemies.addPattern(makeDirectAtPlayerPattern(rate, 240.0f, 400.0f, false)));
+        }
+    }
+
+    // Spawn a separate fourth enemy that is not part of the patrol path and sits near the top-right area.
+    {
+        float bx = WORLD_WIDTH * 0.72f;
+        float by = WORLD_HEIGHT * 0.22f;
+        EnemyId beamEnemy = enemies.spawn(bx, by, 40.0f);
+        // No track set - it will use its simple wandering movement or remain mostly stationary
+        // Use a simple direct-at-player pattern instead of the lingering beam
+        enemies.setPattern(beamEnemy, enemies.addPattern(makeDirectAtPlayerPattern(2.0f, 180.0f, 800.0f, true)));
+    }
+}
+
+void Simulation::setJobSystem(JobSystem* jobSystem) {
+    jobs = jobSystem;
+    queryContexts.resize(jobs ? jobs->getThreadCount() : 1);
+}
+
+void Simulation::handleKey(sf::Keyboard::Key key, bool isPressed) {
+    playerShip.handleInput(key, isPressed);
+    // Forward aim keys (IJKL) to ship for twin-stick ground mode aiming
+    playerShip.handleAimInput(key, isPressed);
+}
+
+void Simulation::setAimTarget(const sf::Vector2f& target) {
+    aimTarget = target;
+    hasAimTarget = true;
+}
+
+void Simulation::update(float deltaTime) {
+    ++tickCount;
+    elapsedTime += deltaTime;
+    tickEvents = TickEvents();
+    previousScrollX = backgroundScrollX;
+    previousScrollY = backgroundScrollY;
+
+    {
+        SHMUP_PROFILE_SCOPE(profiler, ProfilePhase::Update);
+
+        // Update input state
+        playerShip.updateInput();
+
+        // Scroll background when in air mode
+        if (playerShip.getMode() == Ship::Mode::Air) {
+            // Scroll to the left to create illusion of forward movement
+            backgroundScrollY -= SCROLL_SPEED * .5f * deltaTime;
+
+            // Wrap scroll position between 0 and TILE_WIDTH/HEIGHT
+            while (backgroundScrollY >= IsometricUtils::TILE_HEIGHT) backgroundScrollY -= IsometricUtils::TILE_HEIGHT;
+            while (backgroundScrollY < 0.0f) backgroundScrollY += IsometricUtils::TILE_HEIGHT;
+
+            // Add a slight vertical scroll component to enhance the isometric feel
+            backgroundScrollX -= SCROLL_SPEED * deltaTime;
+            while (backgroundScrollX >= IsometricUtils::TILE_WIDTH) backgroundScrollX -= IsometricUtils::TILE_WIDTH;
+            while (backgroundScrollX < 0.0f) backgroundScrollX += IsometricUtils::TILE_WIDTH;
+        }
+
+        // Handle shooting (call shouldShoot each frame - it handles cooldown internally)
+        if (playerShip.shouldShoot()) {
+            sf::Vector2f shipPos = playerShip.getPosition();
+            float angle = playerShip.getForwardAngle();
+
+            // Spawn projectile slightly forward so it doesn't overlap with ship
+            // Offset by ~30 pixels in the forward direction
+            float offsetDistance = 30.0f;
+            sf::Vector2f forward = FastMath::direction(angle);
+            float spawnX = shipPos.x + forward.x * offsetDistance;
+            float spawnY = shipPos.y + forward.y * offsetDistance;
+
+            projectiles.spawn(spawnX, spawnY, angle);
+            ++tickEvents.playerShots;
+        }
+
+        // Update game objects
+        if (hasAimTarget) {
+            playerShip.updateAim(aimTarget); // Update facing based on the aim target
+        }
+        playerShip.update(deltaTime);
+
+        // Update projectiles and remove those that are off screen
+        {
+            SHMUP_PROFILE_SCOPE(profiler, ProfilePhase::Projectiles);
+            forEachChunk(projectiles.size(), PROJECTILE_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t) {
+                projectiles.update(deltaTime, WORLD_WIDTH, WORLD_HEIGHT, begin, end);
+            });
+            projectiles.removeCulled();
+        }
+
+        // Scripted barrages fire, and steer the bullets that are still alive
+        sf::Vector2f playerPos = playerShip.getPosition();
+        {
+            SHMUP_PROFILE_SCOPE(profiler, ProfilePhase::Scripts);
+            bullets.update(deltaTime, projectiles, playerPos);
+        }
+
+        // Enemies whose spawn time has come enter the stage
+        spawner.advance(deltaTime, enemies);
+
+        // Update enemies (pass player position and collect the shots they fire)
+        // Each chunk of enemies fires into its own batch
+        std::size_t enemyChunks = JobSystem::chunkCount(enemies.size(), ENEMY_CHUNK);
+        while (enemySpawns.size() < enemyChunks) enemySpawns.emplace_back(CHUNK_SPAWN_RESERVE);
+        forEachChunk(enemies.size(), ENEMY_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t) {
+            enemies.update(deltaTime, WORLD_WIDTH, WORLD_HEIGHT, playerPos, enemySpawns[begin / ENEMY_CHUNK], begin, end);
+        });
+        // Remove enemies killed by last tick's collisions, and those that flew off at the end of their track
+        enemies.removeDead();
+        enemies.removeDeparted(WORLD_WIDTH, WORLD_HEIGHT);
+
+        // Add every emitted shot. Chunk order is enemy order, so the pool gets the same
+        // projectiles in the same order whichever threads ran the chunks.
+        for (std::size_t c = 0; c < enemyChunks; ++c) {
+            tickEvents.enemyShots += static_cast<std::uint32_t>(enemySpawns[c].size() + enemySpawns[c].getLaunches().size());
+            projectiles.spawn(enemySpawns[c]);
+            bullets.launch(enemySpawns[c], playerPos);
+            enemySpawns[c].clear();
+        }
+    }
+
+    // Check collisions between projectiles, enemies and the player ship
+    {
+        SHMUP_PROFILE_SCOPE(profiler, ProfilePhase::Collisions);
+        checkCollisions();
+    }
+
+    // Keep ship within screen bounds
+    sf::Vector2f pos = playerShip.getPosition();
+    float shipRadius = 15.0f;
+
+    if (pos.x < shipRadius) playerShip.setPosition(shipRadius, pos.y);
+    if (pos.x > WORLD_WIDTH - shipRadius) playerShip.setPosition(WORLD_WIDTH - shipRadius, pos.y);
+    if (pos.y < shipRadius) playerShip.setPosition(pos.x, shipRadius);
+    if (pos.y > WORLD_HEIGHT - shipRadius) playerShip.setPosition(pos.x, WORLD_HEIGHT - shipRadius);
+}
+
+sf::Vector2f Simulation::getBackgroundScroll(float alpha) const {
+    // Scroll wraps at the tile size; blend along the short way round so a wrap does not sweep back
+    auto blend = [alpha](float prev, float cur, float period) {
+        float delta = cur - prev;
+        if (delta > period / 2.0f) delta -= period;
+        if (delta < -period / 2.0f) delta += period;
+        float v = prev + delta * alpha;
+        if (v < 0.0f) v += period;
+        if (v >= period) v -= period;
+        return v;
+    };
+    return sf::Vector2f(blend(previousScrollX, backgroundScrollX, IsometricUtils::TILE_WIDTH),
+                        blend(previousScrollY, backgroundScrollY, IsometricUtils::TILE_HEIGHT));
+}
+
+void Simulation::checkCollisions() {
+    // Every test below is swept: it covers the whole of this tick's motion, not just where things ended up,
+    // so fast shots and low tick rates cannot step over a target. The grids hold each object's swept box.
+    enemyGrid.clear();
+    for (std::size_t e = 0; e < enemies.size(); ++e) {
+        enemyGrid.insert(static_cast<std::uint32_t>(e), enemies.getSweptBounds(e));
+    }
+    enemyGrid.build();
+
+    enemyShotGrid.clear();
+    for (std::size_t i = 0; i < projectiles.size(); ++i) {
+        if (projectiles.getOwner(i) == Projectile::Owner::Enemy) {
+            enemyShotGrid.insert(static_cast<std::uint32_t>(i), projectiles.getSweptBounds(i));
+        }
+    }
+    enemyShotGrid.build();
+
+    projectileHits.clear();
+
+    // Player projectiles against enemies. Chunks only read the world and record hits;
+    // damage is applied afterwards in chunk order, exactly as a serial pass would.
+    std::size_t shotChunks = JobSystem::chunkCount(projectiles.size(), COLLISION_CHUNK);
+    if (shotHits.size() < shotChunks) shotHits.resize(shotChunks);
+    for (SpatialHash::QueryContext& context : queryContexts) context.candidates = 0;
+    forEachChunk(projectiles.size(), COLLISION_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t thread) {
+        std::vector<ShotHit>& hits = shotHits[begin / COLLISION_CHUNK];
+        SpatialHash::QueryContext& context = queryContexts[thread];
+        hits.clear();
+        for (std::size_t i = begin; i < end; ++i) {
+            // Only player-owned projectiles should damage enemies
+            if (projectiles.getOwner(i) != Projectile::Owner::Player) continue;
+            sf::FloatRect bounds = projectiles.getBounds(i);
+            sf::Vector2f motion = projectiles.getMotion(i);
+            // The shot stops at the first enemy along its path this tick
+            std::uint32_t hitEnemy = 0;
+            float hitTime = 2.0f;
+            enemyGrid.query(projectiles.getSweptBounds(i), context, [&](std::uint32_t e) {
+                float time;
+                if (Projectile::checkSweptCollision(bounds, motion, enemies.getBounds(e), enemies.getMotion(e), time)
+                    && (time < hitTime || (time == hitTime && e < hitEnemy))) {
+                    hitTime = time;
+                    hitEnemy = e;
+                }
+                return false;
+            });
+            if (hitTime <= 1.0f) hits.push_back(ShotHit{static_cast<std::uint32_t>(i), hitEnemy});
+        }
+    });
+    for (std::size_t c = 0; c < shotChunks; ++c) {
+        for (const ShotHit& hit : shotHits[c]) {
+            // Projectile hit enemy; if it died it will be removed in the next update
+            bool wasAlive = !enemies.isDead(hit.enemy);
+            enemies.takeDamage(hit.enemy, 1);
+            projectileHits.push_back(hit.projectile);
+            ++tickEvents.enemyHits;
+            if (wasAlive && enemies.isDead(hit.enemy)) ++tickEvents.enemiesDestroyed;
+        }
+    }
+
+    // Enemy projectiles against the player
+    sf::FloatRect shipBounds = playerShip.getBounds();
+    sf::Vector2f shipMotion = playerShip.getMotion();
+    sf::FloatRect shipSwept = playerShip.getSweptBounds();
+    enemyShotGrid.query(shipSwept, [&](std::uint32_t i) {
+        float time;
+        if (Projectile::checkSweptCollision(projectiles.getBounds(i), projectiles.getMotion(i), shipBounds, shipMotion, time)) {
+            playerShip.takeDamage(1);
+            projectileHits.push_back(i);
+            ++tickEvents.playerHits;
+        }
+        return false;
+    });
+
+    // Enemies against the player ship
+    enemyGrid.query(shipSwept, [&](std::uint32_t e) {
+        float time;
+        if (Projectile::checkSweptCollision(enemies.getBounds(e), enemies.getMotion(e), shipBounds, shipMotion, time)) {
+            // Damage player and enemy (simple rules: both take 1)
+            bool wasAlive = !enemies.isDead(e);
+            playerShip.takeDamage(1);
+            enemies.takeDamage(e, 1);
+            ++tickEvents.playerHits;
+            if (wasAlive && enemies.isDead(e)) ++tickEvents.enemiesDestroyed;
+        }
+        return false;
+    });
+
+    // Remove projectiles that hit something. Going from the highest index down keeps the
+    // remaining indices valid, since swap-and-pop only moves the last projectile.
+    std::sort(projectileHits.begin(), projectileHits.end(), std::greater<std::size_t>());
+    for (std::size_t i : projectileHits) {
+        projectiles.remove(i);
+    }
+
+    lastPairTests = enemyGrid.candidateCount() + enemyShotGrid.candidateCount();
+    for (const SpatialHash::QueryContext& context : queryContexts) lastPairTests += context.candidates;
+}
+
+std::uint64_t Simulation::stateHash() const {
+    std::uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    mix(projectiles.positionsX(), projectiles.size() * sizeof(float));
+    mix(projectiles.positionsY(), projectiles.size() * sizeof(float));
+    for (std::size_t e = 0; e < enemies.size(); ++e) {
+        sf::Vector2f p = enemies.getPosition(e);
+        mix(&p, sizeof(p));
+    }
+    sf::Vector2f shipPos = playerShip.getPosition();
+    mix(&shipPos, sizeof(shipPos));
+    int health = playerShip.getHealth();
+    mix(&health, sizeof(health));
+    return hash;
+}
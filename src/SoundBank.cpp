@@ -0,0 +1,54 @@
+#include "SoundBank.h"
+#include <SFML/Audio.hpp>
+#include <utility>
+
+SoundBank::SoundId SoundBank::loadFromFile(const std::string& name, const std::string& path) {
+    SoundId existing = find(name);
+    if (existing != NO_SOUND) return existing;
+
+    sf::SoundBuffer buffer;
+    if (!buffer.loadFromFile(path) || buffer.getChannelCount() == 0) return NO_SOUND;
+    const std::int16_t* samples = buffer.getSamples();
+    std::size_t channels = buffer.getChannelCount();
+    std::size_t frames = static_cast<std::size_t>(buffer.getSampleCount()) / channels;
+
+    std::vector<std::int16_t> mono(frames);
+    for (std::size_t f = 0; f < frames; ++f) {
+        int sum = 0;
+        for (std::size_t c = 0; c < channels; ++c) sum += samples[f * channels + c];
+        mono[f] = static_cast<std::int16_t>(sum / static_cast<int>(channels));
+    }
+    return add(name, std::move(mono), buffer.getSampleRate());
+}
+
+SoundBank::SoundId SoundBank::add(const std::string& name, std::vector<std::int16_t> samples, unsigned sampleRate) {
+    SoundId existing = find(name);
+    if (existing != NO_SOUND) return existing;
+    if (sounds.size() >= NO_SOUND || sampleRate == 0) return NO_SOUND;
+
+    SoundId id = static_cast<SoundId>(sounds.size());
+    sounds.push_back(Sound{std::move(samples), sampleRate});
+    names[name] = id;
+    return id;
+}
+
+SoundBank::SoundId SoundBank::addBlip(const std::string& name, float startHz, float endHz, float seconds,
+                                      unsigned sampleRate) {
+    std::size_t count = static_cast<std::size_t>(seconds * sampleRate);
+    std::vector<std::int16_t> samples(count);
+    const float amplitude = 0.3f * 32767.0f;
+    float phase = 0.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+        float t = static_cast<float>(i) / static_cast<float>(count);
+        phase += (startHz + (endHz - startHz) * t) / static_cast<float>(sampleRate);
+        if (phase >= 1.0f) phase -= 1.0f;
+        float level = amplitude * (1.0f - t);
+        samples[i] = static_cast<std::int16_t>(phase < 0.5f ? level : -level);
+    }
+    return add(name, std::move(samples), sampleRate);
+}
+
+SoundBank::SoundId SoundBank::find(const std::string& name) const {
+    auto it = names.find(name);
+    return it == names.end() ? NO_SOUND : it->second;
+}
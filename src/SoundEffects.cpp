@@ -0,0 +1,58 @@
+#include "SoundEffects.h"
+#include <filesystem>
+
+namespace {
+
+struct Effect {
+    const char* name;
+    // Stand-in blip
+    float startHz;
+    float endHz;
+    float seconds;
+    // Mixing
+    float volume;
+    std::uint8_t priority; // being hit outranks everything; enemy fire is the first to lose its voice
+};
+
+const Effect EFFECTS[SoundEffects::Count] = {
+    { "player_shot",     1200.0f, 600.0f, 0.06f, 0.45f, 1 },
+    { "enemy_shot",       520.0f, 360.0f, 0.05f, 0.30f, 0 },
+    { "enemy_hit",        320.0f, 200.0f, 0.04f, 0.50f, 1 },
+    { "enemy_destroyed",  420.0f,  60.0f, 0.35f, 0.80f, 2 },
+    { "player_hit",       160.0f,  70.0f, 0.30f, 1.00f, 3 },
+};
+
+} // namespace
+
+int SoundEffects::load(SoundBank& bank, const std::string& directory) {
+    int fromFiles = 0;
+    for (const Effect& effect : EFFECTS) {
+        SoundBank::SoundId id = SoundBank::NO_SOUND;
+        // Only open files that exist; each failed open costs a decoder probe
+        for (const char* extension : { ".wav", ".ogg", ".flac" }) {
+            std::string path = directory + "/" + effect.name + extension;
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(path, ec)) {
+                id = bank.loadFromFile(effect.name, path);
+                if (id != SoundBank::NO_SOUND) break;
+            }
+        }
+        if (id != SoundBank::NO_SOUND) {
+            ++fromFiles;
+        } else {
+            bank.addBlip(effect.name, effect.startHz, effect.endHz, effect.seconds);
+        }
+    }
+    return fromFiles;
+}
+
+void SoundEffects::play(const Simulation::TickEvents& events, SfxMixer& mixer) {
+    // One play per kind of event and tick: a volley of any size is one trigger
+    const std::uint32_t counts[Count] = {
+        events.playerShots, events.enemyShots, events.enemyHits, events.enemiesDestroyed, events.playerHits
+    };
+    for (SoundBank::SoundId id = 0; id < Count; ++id) {
+        if (counts[id] == 0) continue;
+        mixer.play(id, EFFECTS[id].volume, 0.0f, 1.0f, EFFECTS[id].priority);
+    }
+}
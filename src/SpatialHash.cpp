@@ -0,0 +1,57 @@
+#include "SpatialHash.h"
+#include <cmath>
+
+SpatialHash::SpatialHash(float width, float height, float cellSize)
+    : m_invCellSize(1.0f / cellSize),
+      m_cols(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+      m_rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))),
+      m_cellStart(static_cast<std::size_t>(m_cols) * m_rows + 1, 0u),
+      m_objectCount(0), m_idLimit(0) {}
+
+int SpatialHash::cellX(float x) const {
+    int c = static_cast<int>(std::floor(x * m_invCellSize));
+    return std::min(std::max(c, 0), m_cols - 1);
+}
+
+int SpatialHash::cellY(float y) const {
+    int c = static_cast<int>(std::floor(y * m_invCellSize));
+    return std::min(std::max(c, 0), m_rows - 1);
+}
+
+void SpatialHash::clear() {
+    m_pending.clear();
+    m_items.clear();
+    std::fill(m_cellStart.begin(), m_cellStart.end(), 0u);
+    m_objectCount = 0;
+    m_context.candidates = 0;
+}
+
+void SpatialHash::insert(std::uint32_t id, const sf::FloatRect& bounds) {
+    int x0 = cellX(bounds.position.x);
+    int x1 = cellX(bounds.position.x + bounds.size.x);
+    int y0 = cellY(bounds.position.y);
+    int y1 = cellY(bounds.position.y + bounds.size.y);
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            m_pending.push_back(Entry{static_cast<std::uint32_t>(cy * m_cols + cx), id});
+        }
+    }
+
+    m_idLimit = std::max(m_idLimit, static_cast<std::size_t>(id) + 1);
+    ++m_objectCount;
+}
+
+void SpatialHash::build() {
+    // Counting sort of the pending entries by cell: count, prefix sum, scatter
+    std::size_t cellCount = m_cellStart.size() - 1;
+    std::fill(m_cellStart.begin(), m_cellStart.end(), 0u);
+    for (const Entry& e : m_pending) ++m_cellStart[e.cell + 1];
+    for (std::size_t c = 0; c < cellCount; ++c) m_cellStart[c + 1] += m_cellStart[c];
+
+    m_items.resize(m_pending.size());
+    // Scatter using the start offsets, then shift them back so m_cellStart[c] is the run start again
+    for (const Entry& e : m_pending) m_items[m_cellStart[e.cell]++] = e.id;
+    for (std::size_t c = cellCount; c > 0; --c) m_cellStart[c] = m_cellStart[c - 1];
+    m_cellStart[0] = 0;
+}
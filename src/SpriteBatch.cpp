@@ -0,0 +1,97 @@
+#include "SpriteBatch.h"
+#include "FastMath.h"
+#include <utility>
+
+SpriteBatch::SpriteBatch()
+    : m_activeBuckets(0), m_spriteCount(0), m_drawCalls(0) {}
+
+SpriteBatch::Bucket& SpriteBatch::bucketFor(const sf::Texture& texture) {
+    // Only a handful of textures are live per layer, so a linear search beats a map here
+    for (std::size_t i = 0; i < m_activeBuckets; ++i) {
+        if (m_buckets[i].texture == &texture) return m_buckets[i];
+    }
+
+    // Reuse an idle bucket (and its vertex storage) before growing the list
+    if (m_activeBuckets == m_buckets.size()) {
+        m_buckets.push_back(Bucket{nullptr, sf::VertexArray(sf::PrimitiveType::Triangles)});
+    }
+    Bucket& bucket = m_buckets[m_activeBuckets++];
+    bucket.texture = &texture;
+    bucket.vertices.clear();
+    return bucket;
+}
+
+void SpriteBatch::draw(const sf::Texture& texture, const sf::IntRect& frame, sf::Vector2f position,
+                       sf::Vector2f origin, float rotationDeg, sf::Color tint, sf::Vector2f scale) {
+    sf::Vector2f rotation(1.0f, 0.0f);
+    if (rotationDeg != 0.0f) {
+        rotation = FastMath::direction(rotationDeg * FastMath::PI / 180.0f);
+    }
+    drawRotated(texture, frame, position, origin, rotation, tint, scale);
+}
+
+void SpriteBatch::drawRotated(const sf::Texture& texture, const sf::IntRect& frame, sf::Vector2f position,
+                              sf::Vector2f origin, sf::Vector2f rotation, sf::Color tint, sf::Vector2f scale) {
+    Bucket& bucket = bucketFor(texture);
+
+    // Local corners relative to the pivot, scaled
+    float w = static_cast<float>(frame.size.x);
+    float h = static_cast<float>(frame.size.y);
+    float x0 = -origin.x * scale.x;
+    float y0 = -origin.y * scale.y;
+    float x1 = (w - origin.x) * scale.x;
+    float y1 = (h - origin.y) * scale.y;
+
+    sf::Vector2f corners[4] = { {x0, y0}, {x1, y0}, {x1, y1}, {x0, y1} };
+    if (rotation.x != 1.0f || rotation.y != 0.0f) {
+        float c = rotation.x;
+        float s = rotation.y;
+        for (sf::Vector2f& p : corners) {
+            p = sf::Vector2f(p.x * c - p.y * s, p.x * s + p.y * c);
+        }
+    }
+
+    float u0 = static_cast<float>(frame.position.x);
+    float v0 = static_cast<float>(frame.position.y);
+    float u1 = u0 + w;
+    float v1 = v0 + h;
+    sf::Vector2f uvs[4] = { {u0, v0}, {u1, v0}, {u1, v1}, {u0, v1} };
+
+    // Two triangles per quad: 0-1-2 and 0-2-3
+    static const int order[6] = { 0, 1, 2, 0, 2, 3 };
+    for (int k : order) {
+        sf::Vertex v;
+        v.position = position + corners[k];
+        v.color = tint;
+        v.texCoords = uvs[k];
+        bucket.vertices.append(v);
+    }
+    ++m_spriteCount;
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target, const sf::RenderStates& states) {
+    for (std::size_t i = 0; i < m_activeBuckets; ++i) {
+        Bucket& bucket = m_buckets[i];
+        if (bucket.vertices.getVertexCount() == 0) continue;
+
+        sf::RenderStates bucketStates = states;
+        bucketStates.texture = bucket.texture;
+        target.draw(bucket.vertices, bucketStates);
+        ++m_drawCalls;
+
+        bucket.vertices.clear();
+    }
+    m_activeBuckets = 0;
+}
+
+void SpriteBatch::discard() {
+    for (std::size_t i = 0; i < m_activeBuckets; ++i) {
+        m_buckets[i].vertices.clear();
+    }
+    m_activeBuckets = 0;
+}
+
+void SpriteBatch::resetStats() {
+    m_spriteCount = 0;
+    m_drawCalls = 0;
+}
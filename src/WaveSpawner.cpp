@@ -0,0 +1,77 @@
+#include "WaveSpawner.h"
+#include "LevelData.h"
+#include "EnemyWorld.h"
+#include "PathTrack.h"
+#include "ShootingPattern.h"
+
+WaveSpawner::WaveSpawner()
+    : level(nullptr), next(0), stageTime(0.0f) {}
+
+void WaveSpawner::start(const LevelData& newLevel) {
+    level = &newLevel;
+    next = 0;
+    stageTime = 0.0f;
+    tracks.assign(level->getTrackCount(), EnemyWorld::NO_TRACK);
+    patterns.assign(level->getPatternCount(), EnemyWorld::NO_PATTERN);
+}
+
+std::size_t WaveSpawner::getPending() const {
+    return level ? level->getSpawnCount() - next : 0;
+}
+
+void WaveSpawner::advance(float deltaTime, EnemyWorld& world) {
+    if (!level) return;
+    stageTime += deltaTime;
+
+    std::size_t count = level->getSpawnCount();
+    for (; next < count && level->getSpawn(next).time <= stageTime; ++next) {
+        const LevelFormat::Spawn& spawn = level->getSpawn(next);
+        EnemyId enemy = world.spawn(spawn.x, spawn.y, spawn.speed, spawn.health);
+        if (!enemy.isValid()) continue; // world full: the spawn is dropped
+        if (spawn.track >= 0) {
+            world.setTrack(enemy, worldTrack(spawn.track, world), spawn.trackSpeed, spawn.trackDistance,
+                           sf::Vector2f(spawn.x, spawn.y));
+        }
+        if (spawn.pattern >= 0) {
+            world.setPattern(enemy, worldPattern(spawn.pattern, world));
+        }
+    }
+}
+
+std::int32_t WaveSpawner::worldTrack(std::int32_t levelTrack, EnemyWorld& world) {
+    std::int32_t& index = tracks[static_cast<std::size_t>(levelTrack)];
+    if (index == EnemyWorld::NO_TRACK) {
+        const LevelFormat::Track& track = level->getTrack(static_cast<std::size_t>(levelTrack));
+        const LevelFormat::Point* points = level->getPoints() + track.firstPoint;
+        std::vector<sf::Vector2f> waypoints;
+        waypoints.reserve(track.pointCount);
+        for (std::uint32_t p = 0; p < track.pointCount; ++p) {
+            waypoints.push_back(sf::Vector2f(points[p].x, points[p].y));
+        }
+        index = world.addTrack(std::make_shared<PathTrack>(
+            waypoints, track.catmullRom ? PathTrack::Shape::CatmullRom : PathTrack::Shape::Polyline, track.loop != 0));
+    }
+    return index;
+}
+
+std::int32_t WaveSpawner::worldPattern(std::int32_t levelPattern, EnemyWorld& world) {
+    std::int32_t& index = patterns[static_cast<std::size_t>(levelPattern)];
+    if (index == EnemyWorld::NO_PATTERN) {
+        const LevelFormat::Pattern& p = level->getPattern(static_cast<std::size_t>(levelPattern));
+        switch (p.kind) {
+        case LevelFormat::Radial:
+            index = world.addPattern(makeRadialPattern(p.count, p.interval, p.speed));
+            break;
+        case LevelFormat::Spread:
+            index = world.addPattern(makeSpreadPattern(p.count, p.arcDegrees, p.interval, p.speed));
+            break;
+        case LevelFormat::Script:
+            index = world.addPattern(makeScriptedPattern(p.count, p.interval));
+            break;
+        default:
+            index = world.addPattern(makeDirectAtPlayerPattern(p.interval, p.speed, p.range, p.always != 0));
+            break;
+        }
+    }
+    return index;
+}
@@ -1,10 +1,268 @@
 #include "Game.h"
+#include "Simulation.h"
+#include "AssetCache.h"
+#include "PlayfieldRenderer.h"
+#include "Projectile.h"
+#include "Enemy.h"
+#include "JobSystem.h"
+#include "InputRecording.h"
+#include "LevelData.h"
+#include "SoundBank.h"
+#include "SfxMixer.h"
+#include "SoundEffects.h"
 #include <iostream>
 #include <exception>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage(const char* exe) {
+    std::cout << "Usage: " << exe << " [--tick-rate HZ] [--headless] [--frames N] [--dt SECONDS] [--threads N] [--seed N]\n"
+              << "       [--level FILE] [--record FILE] [--replay FILE] [--screenshot FILE] [--sfx-out FILE]\n"
+              << "       [--late-latch] [--compile-level SOURCE OUT]\n"
+              << "  --tick-rate HZ     simulation steps per second (default 120)\n"
+              << "  --headless         run the simulation without a window and report its speed\n"
+              << "  --frames N         number of ticks to simulate in headless mode (default 3600)\n"
+              << "  --dt SECONDS       tick length in headless mode (default 1 / tick rate)\n"
+              << "  --threads N        headless: threads sharing the simulation update (default: one per core)\n"
+              << "  --seed N           headless: world seed (default 1; windowed sessions pick a fresh one)\n"
+              << "  --level FILE       level to play, compiled or text (default assets/levels/stage1.txt)\n"
+              << "  --record FILE      write the session's input recording to FILE (default last_session.replay, \"\" = off)\n"
+              << "  --replay FILE      re-run a recorded session: windowed, or with --headless at full speed\n"
+              << "  --screenshot FILE  headless: render the final playfield frame and save it (PNG)\n"
+              << "  --sfx-out FILE     headless: mix the run's sound effects offline and save them (WAV)\n"
+              << "  --late-latch       re-sample input right before each render to cut input latency (F4 toggles)\n"
+              << "  --compile-level SOURCE OUT  compile a text level into the binary form and exit\n";
+}
+
+// Render the simulation's current state into an offscreen playfield and write it to disk.
+// `assets` must outlive every later draw of the simulation.
+bool saveScreenshot(Simulation& simulation, AssetCache& assets, const std::string& path) {
+    if (!assets.load("assets/characters")) {
+        std::cerr << "Screenshot: no sprite sheets loaded, only the floor will be visible" << std::endl;
+    }
+    Projectile::loadTexture(assets);
+    Enemy::loadTexture(assets);
+    simulation.getShip().loadTexture(assets);
+
+    PlayfieldRenderer playfield;
+    return playfield.render(simulation, 1.0f) && playfield.capture().saveToFile(path);
+}
+
+// Play one tick's sound effects and mix the audio up to endSeconds, as a game frame of that one tick would
+void mixTickSounds(const Simulation& simulation, SfxMixer& mixer, double endSeconds, std::vector<std::int16_t>& audio) {
+    SoundEffects::play(simulation.getTickEvents(), mixer);
+    mixer.flush();
+    std::size_t end = static_cast<std::size_t>(endSeconds * mixer.getSampleRate()) * SfxMixer::CHANNELS;
+    std::size_t begin = audio.size();
+    if (end <= begin) return;
+    audio.resize(end);
+    mixer.render(audio.data() + begin, (end - begin) / SfxMixer::CHANNELS);
+}
+
+bool saveSounds(const std::vector<std::int16_t>& audio, unsigned sampleRate, const std::string& path) {
+    sf::SoundBuffer buffer;
+    return buffer.loadFromSamples(audio.data(), audio.size(), SfxMixer::CHANNELS, sampleRate,
+                                  { sf::SoundChannel::FrontLeft, sf::SoundChannel::FrontRight })
+           && buffer.saveToFile(path);
+}
+
+// Text level to the compiled form that loads without parsing
+int compileLevelFile(const std::string& sourcePath, const std::string& outPath) {
+    std::ifstream source(sourcePath);
+    if (!source) {
+        std::cerr << "Cannot open " << sourcePath << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::string text((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+    std::vector<std::uint8_t> compiled;
+    std::string error;
+    if (!compileLevel(text, compiled, error, std::filesystem::path(sourcePath).parent_path().string())) {
+        std::cerr << sourcePath << ", " << error << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(compiled.data()), static_cast<std::streamsize>(compiled.size()));
+    if (!out) {
+        std::cerr << "Cannot write " << outPath << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Compiled " << sourcePath << " to " << outPath << " (" << compiled.size() << " bytes)" << std::endl;
+    return 0;
+}
+
+// Tick the simulation as fast as possible for a fixed number of frames and report throughput.
+// With a recording, its seed, tick length, length and input are used instead.
+int runHeadless(int frames, float dt, std::uint32_t seed, std::size_t workers, const std::string& levelPath,
+                const InputRecording* replay, const std::string& screenshotPath, const std::string& sfxPath) {
+    if (replay) {
+        frames = static_cast<int>(replay->getTickCount());
+        dt = replay->getTickLength();
+        seed = replay->getSeed();
+    }
+
+    AssetCache assets; // only filled for a screenshot
+    JobSystem jobs(workers);
+    Simulation simulation;
+    simulation.setSeed(seed);
+    std::string levelError;
+    if (!simulation.loadLevel(levelPath, levelError)) {
+        std::cerr << "Level " << levelError << "; using the default enemy formation" << std::endl;
+        simulation.spawnDefaultEnemies();
+    }
+    simulation.setJobSystem(&jobs);
+
+    // Offline sound, mixed tick by tick outside the tick timings
+    SoundBank sounds;
+    std::unique_ptr<SfxMixer> sfx;
+    std::vector<std::int16_t> audio;
+    if (!sfxPath.empty()) {
+        SoundEffects::load(sounds, "assets/sounds");
+        sfx = std::make_unique<SfxMixer>(sounds);
+        audio.reserve((static_cast<std::size_t>(frames * static_cast<double>(dt) * sfx->getSampleRate()) + 1)
+                      * SfxMixer::CHANNELS);
+    }
+
+    // The slowest tick is the one to profile; a replay reaches it again at the same tick every run
+    std::size_t replayCursor = 0;
+    int slowestTick = -1;
+    double slowestSeconds = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        auto tickStart = std::chrono::steady_clock::now();
+        if (replay) replay->apply(simulation, replayCursor);
+        simulation.update(dt);
+        std::chrono::duration<double> tickTime = std::chrono::steady_clock::now() - tickStart;
+        if (tickTime.count() > slowestSeconds) {
+            slowestSeconds = tickTime.count();
+            slowestTick = i;
+        }
+        if (sfx) mixTickSounds(simulation, *sfx, (i + 1) * static_cast<double>(dt), audio);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double seconds = elapsed.count();
+    double fps = seconds > 0.0 ? frames / seconds : 0.0;
+    std::cout << "Headless: " << frames << " frames at dt=" << dt << "s in " << seconds << "s"
+              << " (" << fps << " frames/s, " << (fps * dt) << "x real time, " << jobs.getThreadCount() << " threads)"
+              << " projectiles=" << simulation.getProjectiles().size()
+              << " enemies=" << simulation.getEnemies().size()
+              << " playerHealth=" << simulation.getShip().getHealth() << std::endl;
+    std::cout << "Seed " << seed << ", state hash " << std::hex << simulation.stateHash() << std::dec
+              << ", slowest tick " << slowestTick << " (" << slowestSeconds * 1000.0 << " ms)" << std::endl;
+
+    if (!screenshotPath.empty()) {
+        if (!saveScreenshot(simulation, assets, screenshotPath)) {
+            std::cerr << "Failed to write screenshot " << screenshotPath << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Saved playfield to " << screenshotPath << std::endl;
+    }
+
+    if (sfx) {
+        // The hash, like the state hash, only changes when the sounds triggered or the mixing change
+        std::uint64_t hash = 1469598103934665603ull;
+        for (std::int16_t sample : audio) {
+            hash = (hash ^ static_cast<std::uint16_t>(sample)) * 1099511628211ull;
+        }
+        SfxMixer::Stats stats = sfx->getStats();
+        std::cout << "Sound: " << audio.size() / SfxMixer::CHANNELS / static_cast<double>(sfx->getSampleRate())
+                  << "s mixed, " << stats.started << " sounds started (" << stats.coalesced << " plays coalesced, "
+                  << stats.stolen << " voices stolen, " << stats.dropped << " dropped), peak " << stats.peakVoices
+                  << " of " << sfx->getVoiceCount() << " voices, hash " << std::hex << hash << std::dec << std::endl;
+        if (!saveSounds(audio, sfx->getSampleRate(), sfxPath)) {
+            std::cerr << "Failed to write sound effects " << sfxPath << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Saved sound effects to " << sfxPath << std::endl;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool headless = false;
+    int frames = 3600;
+    float tickRate = Game::DEFAULT_TICK_RATE;
+    float dt = 0.0f;
+    std::size_t workers = JobSystem::defaultWorkerCount();
+    std::uint32_t seed = EnemyWorld::DEFAULT_SEED;
+    std::string levelPath = Game::DEFAULT_LEVEL_PATH;
+    std::string recordPath = Game::DEFAULT_RECORD_PATH;
+    std::string replayPath;
+    std::string screenshotPath;
+    std::string sfxPath;
+    bool lateLatch = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            tickRate = static_cast<float>(std::atof(argv[++i]));
+            if (tickRate <= 0.0f) tickRate = Game::DEFAULT_TICK_RATE;
+        } else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) {
+            dt = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            int threads = std::atoi(argv[++i]);
+            workers = threads > 1 ? static_cast<std::size_t>(threads - 1) : 0;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            levelPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--compile-level") == 0 && i + 2 < argc) {
+            std::string sourcePath = argv[++i];
+            return compileLevelFile(sourcePath, argv[++i]);
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--screenshot") == 0 && i + 1 < argc) {
+            screenshotPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--sfx-out") == 0 && i + 1 < argc) {
+            sfxPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--late-latch") == 0) {
+            lateLatch = true;
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    InputRecording replay;
+    if (!replayPath.empty()) {
+        if (!replay.loadFromFile(replayPath)) {
+            std::cerr << "Could not read input recording " << replayPath << std::endl;
+            return EXIT_FAILURE;
+        }
+        // A different level would diverge from the first spawn on, so refuse it rather than replay nonsense
+        LevelData level;
+        std::uint64_t levelHash = level.loadFromFile(levelPath) ? level.contentHash() : 0;
+        if (levelHash != replay.getLevelHash()) {
+            std::cerr << "Input recording " << replayPath << " was made on a different level than " << levelPath
+                      << "; pass the --level it was played with" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Replaying " << replayPath << ": " << replay.getTickCount() << " ticks, "
+                  << replay.getEvents().size() << " input events, seed " << replay.getSeed() << std::endl;
+    }
+    const InputRecording* replaying = replayPath.empty() ? nullptr : &replay;
 
-int main() {
     try {
-        Game game;
+        if (headless) {
+            return runHeadless(frames, dt > 0.0f ? dt : 1.0f / tickRate, seed, workers, levelPath, replaying, screenshotPath,
+                               sfxPath);
+        }
+        Game game(tickRate, levelPath, recordPath, replaying, lateLatch);
         game.run();
     } catch (const std::exception& ex) {
         std::cerr << "Unhandled exception: " << ex.what() << std::endl;
@@ -16,4 +274,3 @@ int main() {
 
     return 0;
 }
-